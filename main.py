@@ -1,15 +1,31 @@
 from fastapi import FastAPI, HTTPException
 from pydantic import BaseModel, Field
-import subprocess
+import asyncio
 import json
-import uuid
+import subprocess
 import os
-from typing import List, Dict, Any
+import sys
+from array import array
+from typing import List, Dict, Any, Literal, Tuple
+
+from scheduler_client import SchedulerClient, SchedulerError, start_scheduler_daemon, stop_scheduler_daemon
 
 # --- 常量定义 ---
 SCHEDULER_CPP_DIR = "scheduler_cpp"
 SCHEDULER_EXECUTABLE = os.path.join(SCHEDULER_CPP_DIR, "main")
-IO_DIRECTORY = f"/tmp/vemu_scheduler_io_{os.getpid()}"
+SCHEDULER_SOCKET = f"/tmp/vemu_scheduler_{os.getpid()}.sock"
+# 常驻调度服务并发处理请求的线程数
+SCHEDULER_THREADS = int(os.environ.get("SCHEDULER_THREADS", os.cpu_count() or 1))
+# native: 进程内扩展模块 heft_native（make python）；daemon: 常驻调度服务（main --serve）
+SCHEDULER_BACKEND = os.environ.get("SCHEDULER_BACKEND", "native")
+# daemon 后端的调度结果缓存：内存条目数与可选的磁盘目录
+SCHEDULER_CACHE_ENTRIES = int(os.environ.get("SCHEDULER_CACHE_ENTRIES", "256"))
+SCHEDULER_CACHE_DIR = os.environ.get("SCHEDULER_CACHE_DIR") or None
+
+heft_native = None
+
+scheduler_process = None
+scheduler_client: SchedulerClient = None
 
 # --- API 数据模型定义 ---
 
@@ -39,6 +55,8 @@ class ScheduleRequest(BaseModel):
     """调度请求的完整结构"""
     dag: DAG
     resources: Resources
+    # 规划算法：heft，或 peft（按乐观代价表前瞻后继的放置）
+    planner: Literal["heft", "peft"] = "heft"
 
 class ScheduledTaskInput(BaseModel):
     source_variable: str = Field(alias="sourceVariable")
@@ -69,7 +87,26 @@ app = FastAPI(
     version="1.2.0",
 )
 
-def convert_dag_to_heft_input(dag: DAG) -> List[Dict[str, Any]]:
+def convert_resources_to_hardware(resources: Resources) -> Dict[str, Any]:
+    """
+    将请求中的硬件资源转换为 C++ 调度器的硬件描述（格式见 scheduler_cpp/include/HardwareDescription.hpp）：
+    每个 core 一个 TILE，tileId 即 core.id，SPM 大小为 memorySizeKb；片上网络按 TILE 数取默认的 mesh。
+    core.type 暂不区分，所有 TILE 能力相同。
+    """
+    return {"tiles": [
+        {
+            "tileId": core.id,
+            "computationCapacity": 1,   # 与任务的 computationCost 占位符一致
+            "spm_size": resources.memory_size_kb,
+            "num_lane": 1,
+            "has_bitalu": False,
+            "has_serdiv": False,
+            "has_complexunit": False,
+        }
+        for core in resources.cores
+    ]}
+
+def convert_dag_to_heft_input(dag: DAG, resources: Resources) -> List[Dict[str, Any]]:
     """
     将标准的 DAG 格式转换为 C++ HEFT 调度器期望的输入格式。
     """
@@ -83,7 +120,10 @@ def convert_dag_to_heft_input(dag: DAG) -> List[Dict[str, Any]]:
     for edge in dag.edges:
         # C++调度器需要outputIndex和inputIndex, 这里我们用0作为占位符
         # C++调度器还需要outputVar和inputVar, 我们用边连接的节点ID来构造一个名字
-        parent_task = {"taskId": edge.from_node, "outputIndex": 0, "outputVar": f"data_from_{edge.from_node}_to_{edge.to_node}", "concat_value": 0, "dest_address": "null"}
+        # dest_address 为 "null"：只作调度依赖，不写入 all_input；切片给出传输字节数（dataSize 个 1 字节元素），
+        # 与 convert_dag_to_native_arrays 的 edge_bytes 一致，两种后端使用相同的通信代价
+        parent_task = {"taskId": edge.from_node, "outputIndex": 0, "outputVar": f"data_from_{edge.from_node}_to_{edge.to_node}", "concat_value": 0, "dest_address": "null",
+                       "slice_length": str(edge.data_size), "slice_data_type": "1"}
         child_task = {"taskId": edge.to_node, "inputIndex": 0, "inputVar": f"data_from_{edge.from_node}_to_{edge.to_node}", "concat_value": 0}
         
         adj_list[edge.to_node]["parentTasks"].append(parent_task)
@@ -94,9 +134,9 @@ def convert_dag_to_heft_input(dag: DAG) -> List[Dict[str, Any]]:
             "taskId": node.id,
             # 以下是 C++ 调度器需要的、但标准DAG中没有的字段
             # 我们使用合理的默认值或占位符
-            "computationCost": 100, # 占位符
-            "spm_size": 1024,       # 占位符
-            "num_lane": 4,          # 占位符
+            "computationCost": 1,   # 占位符，不超过默认 TILE 的 computationCapacity
+            "spm_size": resources.memory_size_kb,  # 与 convert_resources_to_hardware 的 TILE 能力一致，否则没有可用的 TILE
+            "num_lane": 1,          # 占位符
             "has_bitalu": 0,        # 占位符
             "has_serdiv": 0,        # 占位符
             "has_complexunit": 0,   # 占位符
@@ -158,15 +198,47 @@ def convert_heft_output_to_schedule(heft_output: List[Dict[str, Any]]) -> Schedu
 
         scheduled_tasks.append(ScheduledTask(
             taskId=task_id,
-            # HEFT的输出没有core_id和start_cycle，使用占位符
-            core_id=0,
-            start_cycle=0,
+            # HEFT 分配阶段给出的 TILE 与开始周期
+            coreId=task_data.get("core_id", 0),
+            startCycle=task_data.get("start_cycle", 0),
             inputs=inputs,
             outputs=outputs
         ))
         
     return ScheduleResponse(schedule=scheduled_tasks)
 
+def convert_dag_to_native_arrays(dag: DAG) -> Tuple[List[str], array, array, array, array]:
+    """
+    将 DAG 转换为 heft_native.plan 所需的类型化数组：任务下标即 dag.nodes 中的位置，
+    每条边的 dataSize 作为通信代价模型的传输字节数。
+    """
+    index = {node.id: i for i, node in enumerate(dag.nodes)}
+    costs = array("d", [1.0] * len(dag.nodes))  # 占位符，与 convert_dag_to_heft_input 一致
+    edge_source = array("i", [index[edge.from_node] for edge in dag.edges])
+    edge_target = array("i", [index[edge.to_node] for edge in dag.edges])
+    edge_bytes = array("i", [edge.data_size for edge in dag.edges])
+    return [node.id for node in dag.nodes], costs, edge_source, edge_target, edge_bytes
+
+
+def convert_native_plan_to_schedule(task_ids: List[str], plan: List[Tuple[int, int, int, int]]) -> ScheduleResponse:
+    """
+    heft_native.plan 的结果按 rank 顺序给出 (task, core_id, start_cycle, finish_cycle)。
+    """
+    return ScheduleResponse(schedule=[
+        ScheduledTask(taskId=task_ids[task], coreId=core_id, startCycle=start_cycle, inputs=[], outputs=[])
+        for task, core_id, start_cycle, _ in plan
+    ])
+
+
+def build_native_module() -> None:
+    """编译并导入进程内扩展模块"""
+    global heft_native
+    subprocess.run(["make", "python"], cwd=SCHEDULER_CPP_DIR, check=True, capture_output=True, text=True)
+    sys.path.insert(0, os.path.abspath(SCHEDULER_CPP_DIR))
+    import heft_native as module
+    heft_native = module
+
+
 @app.on_event("startup")
 async def startup_event():
     """在服务启动时执行的事件"""
@@ -190,8 +262,28 @@ async def startup_event():
                 f"Failed to compile C++ scheduler in '{SCHEDULER_CPP_DIR}'. "
                 f"Error: {error_message}"
             )
-    # 确保用于数据交换的目录存在
-    os.makedirs(IO_DIRECTORY, exist_ok=True)
+    if SCHEDULER_BACKEND == "native":
+        try:
+            build_native_module()
+        except (subprocess.CalledProcessError, ImportError) as e:
+            error_message = e.stderr if hasattr(e, 'stderr') else str(e)
+            raise RuntimeError(f"Failed to build the heft_native extension. Error: {error_message}")
+        return
+
+    # 启动常驻调度服务，之后的请求通过 Unix 套接字发送，不再为每个请求创建进程
+    global scheduler_process, scheduler_client
+    scheduler_process = await start_scheduler_daemon(SCHEDULER_EXECUTABLE, SCHEDULER_SOCKET, SCHEDULER_THREADS,
+                                                     cache_entries=SCHEDULER_CACHE_ENTRIES,
+                                                     cache_dir=SCHEDULER_CACHE_DIR)
+    scheduler_client = SchedulerClient(SCHEDULER_SOCKET, max_connections=SCHEDULER_THREADS)
+
+
+@app.on_event("shutdown")
+async def shutdown_event():
+    """停止常驻调度服务"""
+    if scheduler_client is not None:
+        await scheduler_client.close()
+    await stop_scheduler_daemon(scheduler_process, SCHEDULER_SOCKET)
 
 
 @app.post("/v1/schedule", 
@@ -202,56 +294,32 @@ async def create_schedule(request: ScheduleRequest):
     """
     此端点是服务的核心。它充当了Web API与后端C++调度算法之间的桥梁。
     """
-    # 为本次请求生成一个唯一的ID，用于创建临时文件
-    request_id = str(uuid.uuid4())
-    input_filepath = os.path.join(IO_DIRECTORY, f"{request_id}_input.json")
-    output_filepath = os.path.join(IO_DIRECTORY, f"{request_id}_output.json")
-
     try:
-        # 1. 将API接收的DAG转换为C++程序所需的格式
-        heft_input_data = convert_dag_to_heft_input(request.dag)
-        with open(input_filepath, "w") as f:
-            json.dump(heft_input_data, f, indent=2)
+        hardware = convert_resources_to_hardware(request.resources)
+        if heft_native is not None:
+            # 进程内规划：plan 期间释放 GIL，放到线程池执行，多个请求可以并行规划
+            # 硬件描述在扩展内按文本缓存，相同的 resources 只解析一次；任务能力缺省取第一个 TILE 的能力
+            task_ids, costs, edge_source, edge_target, edge_bytes = convert_dag_to_native_arrays(request.dag)
+            plan = await asyncio.to_thread(heft_native.plan, costs, edge_source, edge_target,
+                                            planner=request.planner, edge_bytes=edge_bytes,
+                                            hardware=json.dumps(hardware))
+            return convert_native_plan_to_schedule(task_ids, plan)
 
-        # 2. 调用C++调度器子进程 (修正了命令行参数)
-        command = [ f"./{os.path.basename(SCHEDULER_EXECUTABLE)}", input_filepath, output_filepath ]
-        
-        process = subprocess.run(
-            command,
-            capture_output=True,
-            text=True,
-            check=True,
-            cwd=os.path.dirname(SCHEDULER_EXECUTABLE)
-        )
-
-        # 3. 读取并解析调度器的输出
-        if not os.path.exists(output_filepath):
-            raise HTTPException(
-                status_code=500, 
-                detail=f"Scheduler did not produce an output file. Stderr: {process.stderr}"
-            )
+        # 1. 将API接收的DAG转换为C++程序所需的格式
+        heft_input_data = convert_dag_to_heft_input(request.dag, request.resources)
 
-        with open(output_filepath, "r") as f:
-            heft_output_data = json.load(f)
+        # 2. 连同硬件描述发送给常驻调度服务并等待调度结果
+        heft_output_data = await scheduler_client.schedule(heft_input_data, request.planner, hardware)
 
-        # 4. 返回结果
+        # 3. 返回结果
         return convert_heft_output_to_schedule(heft_output_data)
 
-    except subprocess.CalledProcessError as e:
-        # C++ 程序执行失败
-        raise HTTPException(
-            status_code=500, 
-            detail=f"Scheduler C++ process failed with exit code {e.returncode}. Stderr: {e.stderr}"
-        )
+    except (SchedulerError, ValueError, RuntimeError) as e:
+        # C++ 调度器拒绝了输入或规划失败
+        raise HTTPException(status_code=500, detail=f"Scheduler failed: {e}")
     except Exception as e:
         # 捕获所有其他错误
         raise HTTPException(status_code=500, detail=f"An unexpected error occurred: {str(e)}")
-    finally:
-        # 5. 清理临时文件
-        if os.path.exists(input_filepath):
-            os.remove(input_filepath)
-        if os.path.exists(output_filepath):
-            os.remove(output_filepath)
 
 
 @app.get("/", summary="Health Check")
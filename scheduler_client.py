@@ -0,0 +1,107 @@
+"""
+常驻 C++ 调度服务（scheduler_cpp/main --serve）的异步客户端。
+
+帧格式：4 字节大端长度 + 负载。请求负载为任务数组 JSON（或 {"planner": ..., "hardware": {...}, "tasks": [...]}），
+应答负载为调度结果 JSON，失败时为 {"error": "..."}；负载 {"command": "stats"} 返回调度结果缓存的计数。
+一个连接同一时刻只承载一个请求，空闲连接在请求之间复用。
+"""
+import asyncio
+import json
+import os
+import struct
+from typing import Any, Dict, List, Optional, Tuple
+
+_HEADER = struct.Struct(">I")
+
+
+class SchedulerError(RuntimeError):
+    """调度服务返回的错误"""
+
+
+class SchedulerClient:
+    def __init__(self, socket_path: str, max_connections: int = 8):
+        self.socket_path = socket_path
+        self._slots = asyncio.Semaphore(max_connections)
+        self._idle: List[Tuple[asyncio.StreamReader, asyncio.StreamWriter]] = []
+
+    async def schedule_raw(self, payload: bytes) -> bytes:
+        """发送一个请求负载，返回应答负载"""
+        async with self._slots:
+            if self._idle:
+                reader, writer = self._idle.pop()
+            else:
+                reader, writer = await asyncio.open_unix_connection(self.socket_path)
+            try:
+                writer.write(_HEADER.pack(len(payload)) + payload)
+                await writer.drain()
+                (size,) = _HEADER.unpack(await reader.readexactly(_HEADER.size))
+                response = await reader.readexactly(size)
+            except BaseException:
+                writer.close()
+                raise
+            self._idle.append((reader, writer))
+            return response
+
+    async def schedule(self, heft_input: List[Any], planner: Optional[str] = None,
+                       hardware: Optional[Dict[str, Any]] = None) -> List[Any]:
+        """
+        heft_input 为 convert_dag_to_heft_input 的结果，返回调度器输出的 JSON；
+        planner 与 hardware（硬件描述）缺省时用服务启动时的设置
+        """
+        if planner is None and hardware is None:
+            request = heft_input
+        else:
+            request = {"tasks": heft_input}
+            if planner is not None:
+                request["planner"] = planner
+            if hardware is not None:
+                request["hardware"] = hardware
+        response = json.loads(await self.schedule_raw(json.dumps(request).encode()))
+        if isinstance(response, dict) and "error" in response:
+            raise SchedulerError(response["error"])
+        return response
+
+    async def stats(self) -> Any:
+        """调度结果缓存的命中/未命中/淘汰计数；服务未启用缓存时 cache 为 None"""
+        return json.loads(await self.schedule_raw(b'{"command": "stats"}'))
+
+    async def close(self) -> None:
+        while self._idle:
+            _, writer = self._idle.pop()
+            writer.close()
+
+
+async def start_scheduler_daemon(executable: str, socket_path: str, threads: int = 1,
+                                 timeout: float = 10.0, cache_entries: int = 0,
+                                 cache_dir: Optional[str] = None) -> asyncio.subprocess.Process:
+    """启动常驻调度服务并等待套接字可连接；cache_entries / cache_dir 启用调度结果缓存"""
+    if os.path.exists(socket_path):
+        os.remove(socket_path)
+    args = [os.path.abspath(executable), "--serve", socket_path, "--threads", str(threads)]
+    if cache_entries > 0:
+        args += ["--cache", str(cache_entries)]
+    if cache_dir:
+        os.makedirs(cache_dir, exist_ok=True)
+        args += ["--cache-dir", cache_dir]
+    process = await asyncio.create_subprocess_exec(*args, stdout=asyncio.subprocess.DEVNULL)
+    deadline = asyncio.get_running_loop().time() + timeout
+    while True:
+        if process.returncode is not None:
+            raise RuntimeError(f"Scheduler daemon exited with code {process.returncode}")
+        try:
+            _, writer = await asyncio.open_unix_connection(socket_path)
+            writer.close()
+            return process
+        except OSError:
+            if asyncio.get_running_loop().time() > deadline:
+                process.kill()
+                raise RuntimeError(f"Scheduler daemon did not listen on {socket_path}")
+            await asyncio.sleep(0.02)
+
+
+async def stop_scheduler_daemon(process: Optional[asyncio.subprocess.Process], socket_path: str) -> None:
+    if process is not None and process.returncode is None:
+        process.terminate()
+        await process.wait()
+    if os.path.exists(socket_path):
+        os.remove(socket_path)
@@ -0,0 +1,167 @@
+// 规划器复用（reset + run，单次规划的临时数组来自 Arena）与每个 DAG 新建规划器的对比。
+//
+//     make bench/arena_bench && ./bench/arena_bench [tasks=5000] [tiles=16] [dags=50]
+//
+// dags 个同规模的随机 DAG 依次规划，统计每次规划（新建 + run，或 reset + run）期间全局 operator new 的
+// 调用次数、申请的字节数与耗时。
+// 第一个 DAG 不计入（复用模式下它负责把各数组和 Arena 撑到稳定大小）。校验两种模式的 rank 与分配结果逐项相同。
+#include "../include/PlanningAlgorithm.hpp"
+#include "../include/HardwareDescription.hpp"
+#include "../include/HEFTPlanningAlgorithm.hpp"
+#include "../include/TaskConverter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+namespace {
+
+std::size_t allocationCount = 0;
+std::size_t allocationBytes = 0;
+
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    allocationBytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// 上面的 operator new 也用 malloc，配对无误；GCC 只看到标准库内联的 operator new 与这里的 free，会误报
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+std::vector<Task> makeTasks(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> cost(1.0, 100.0);
+    std::vector<double> costs(count);
+    std::vector<int> ones(count, 1);
+    std::vector<int> none(count, 0);
+    std::vector<int> sources;
+    std::vector<int> targets;
+    for (int v = 0; v < count; ++v) {
+        costs[v] = cost(rng);
+        for (int k = 0; k < 2 && v > 0; ++k) {
+            int window = std::min(v, 64);
+            sources.push_back(v - 1 - static_cast<int>(rng() % window));
+            targets.push_back(v);
+        }
+    }
+    return TaskConverter::buildTasks(count, costs.data(), ones.data(), ones.data(), none.data(),
+                                     static_cast<int>(sources.size()), sources.data(), targets.data());
+}
+
+struct Result {
+    std::vector<std::pair<int, double>> ranks;
+    std::vector<Event> events;
+};
+
+struct Totals {
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+    double seconds = 0.0;
+};
+
+bool sameResult(const Result& a, const PlanningAlgorithm& planner) {
+    const auto& events = planner.getTaskEvents();
+    if (a.ranks != planner.getRanks() || a.events.size() != events.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        if (a.events[i].tileId != events[i].tileId || a.events[i].start != events[i].start ||
+            a.events[i].finish != events[i].finish) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void report(const char* planner, const char* mode, const Totals& totals, int runs) {
+    std::printf("%-5s %-7s %12.1f %14.1f %10.2f\n", planner, mode, static_cast<double>(totals.allocations) / runs,
+                static_cast<double>(totals.bytes) / runs / 1024.0, totals.seconds / runs * 1000.0);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int taskCount = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int tileCount = argc > 2 ? std::atoi(argv[2]) : 16;
+    int dagCount = argc > 3 ? std::atoi(argv[3]) : 50;
+    if (dagCount < 2) {
+        std::fprintf(stderr, "dags must be at least 2\n");
+        return 1;
+    }
+
+    std::vector<Tile> tiles;
+    for (int p = 0; p < tileCount; ++p) {
+        tiles.push_back({p, 100.0 * (1.0 + p % 4), 1, 1, false, false, false});
+    }
+    auto hardware = std::make_shared<const HardwareDescription>(tiles, MeshTopology());
+    std::vector<std::vector<Task>> dags;
+    for (int d = 0; d < dagCount; ++d) {
+        dags.push_back(makeTasks(taskCount, d + 1));
+    }
+
+    std::printf("tasks=%d tiles=%d dags=%d (per run, first DAG excluded)\n", taskCount, tileCount, dagCount);
+    std::printf("%-5s %-7s %12s %14s %10s\n", "", "mode", "allocations", "allocated KB", "ms");
+    for (const std::string& name : PlanningAlgorithm::names()) {
+        std::vector<Result> expected(dagCount);
+        Totals fresh;
+        for (int d = 0; d < dagCount; ++d) {
+            std::size_t count = allocationCount;
+            std::size_t bytes = allocationBytes;
+            auto begin = std::chrono::steady_clock::now();
+            std::unique_ptr<PlanningAlgorithm> planner = PlanningAlgorithm::create(name, dags[d], hardware);
+            planner->run();
+            if (d > 0) {
+                fresh.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                fresh.allocations += allocationCount - count;
+                fresh.bytes += allocationBytes - bytes;
+            }
+            expected[d] = {planner->getRanks(), planner->getTaskEvents()};
+        }
+
+        Totals reused;
+        std::unique_ptr<PlanningAlgorithm> planner = PlanningAlgorithm::create(name, dags[0], hardware);
+        for (int d = 0; d < dagCount; ++d) {
+            std::size_t count = allocationCount;
+            std::size_t bytes = allocationBytes;
+            auto begin = std::chrono::steady_clock::now();
+            planner->reset(dags[d]);
+            planner->run();
+            if (d > 0) {
+                reused.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                reused.allocations += allocationCount - count;
+                reused.bytes += allocationBytes - bytes;
+            }
+            if (!sameResult(expected[d], *planner)) {
+                std::fprintf(stderr, "%s: reused planner differs on DAG %d\n", name.c_str(), d);
+                return 1;
+            }
+        }
+        report(name.c_str(), "fresh", fresh, dagCount - 1);
+        report(name.c_str(), "reused", reused, dagCount - 1);
+    }
+    return 0;
+}
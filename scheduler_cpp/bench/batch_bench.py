@@ -0,0 +1,95 @@
+"""
+批处理模式与逐输入启动进程（make all 的做法）的吞吐对比。
+
+    python3 bench/batch_bench.py [--exe ./main] [--dags 200] [--nodes 1000] [--threads 1 2 4]
+
+在临时目录中按 ../IJ 的布局（<名字>/slice_updated_tasks.json）生成 --dags 个形状与规模各异的 DAG，然后
+  loop    对每个输入运行一次 ./main <input> <output>，与 Makefile 的 all 目标相同
+  batch   ./main --batch <目录> --out-dir <目录> --threads N
+报告每种方式的总耗时与每秒 DAG 数，并校验批处理的输出与逐进程的输出逐字节一致。
+"""
+import argparse
+import filecmp
+import json
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from gen_dag import SHAPES, make_tiles, write_dag  # noqa: E402
+
+
+def prepare_inputs(workdir, args):
+    rng = random.Random(args.seed)
+    tiles = make_tiles(args.tiles, min(4, args.tiles), 4.0, 100.0, rng)
+    tile_path = os.path.join(workdir, "tiles.json")
+    with open(tile_path, "w") as f:
+        json.dump(tiles, f)
+    input_dir = os.path.join(workdir, "IJ")
+    names = []
+    for k in range(args.dags):
+        name = f"dag{k:05d}"
+        os.makedirs(os.path.join(input_dir, name))
+        nodes = rng.randint(max(1, args.nodes // 4), args.nodes * 2)
+        with open(os.path.join(input_dir, name, "slice_updated_tasks.json"), "w") as f:
+            write_dag(f, SHAPES[k % len(SHAPES)], nodes, tiles, rng)
+        names.append(name)
+    return input_dir, tile_path, names
+
+
+def run_loop(exe, input_dir, tile_path, names, out_dir):
+    os.makedirs(out_dir)
+    begin = time.perf_counter()
+    for name in names:
+        subprocess.run([exe, os.path.join(input_dir, name, "slice_updated_tasks.json"),
+                        os.path.join(out_dir, name + ".json"), "--hardware", tile_path], check=True)
+    return time.perf_counter() - begin
+
+
+def run_batch(exe, input_dir, tile_path, out_dir, threads):
+    begin = time.perf_counter()
+    result = subprocess.run([exe, "--batch", input_dir, "--out-dir", out_dir, "--hardware", tile_path,
+                             "--threads", str(threads)], check=True, capture_output=True, text=True)
+    elapsed = time.perf_counter() - begin
+    return elapsed, json.loads(result.stdout.strip().splitlines()[-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--exe", default="./main")
+    parser.add_argument("--dags", type=int, default=200)
+    parser.add_argument("--nodes", type=int, default=1000, help="平均任务数的一半到两倍之间随机")
+    parser.add_argument("--tiles", type=int, default=16)
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 2, 4])
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    exe = os.path.abspath(args.exe)
+    workdir = tempfile.mkdtemp(prefix="batch_bench")
+    try:
+        input_dir, tile_path, names = prepare_inputs(workdir, args)
+        print(f"{'mode':>10} {'threads':>8} {'seconds':>9} {'DAGs/s':>9} {'speedup':>8}")
+        loop_dir = os.path.join(workdir, "loop")
+        loop_seconds = run_loop(exe, input_dir, tile_path, names, loop_dir)
+        print(f"{'loop':>10} {1:>8} {loop_seconds:>9.3f} {len(names) / loop_seconds:>9.1f} {1.0:>7.2f}x")
+        for threads in args.threads:
+            out_dir = os.path.join(workdir, f"batch{threads}")
+            seconds, summary = run_batch(exe, input_dir, tile_path, out_dir, threads)
+            if summary["failed"]:
+                sys.exit(f"batch run with {threads} threads reported {summary['failed']} failures")
+            for name in names:
+                if not filecmp.cmp(os.path.join(loop_dir, name + ".json"), os.path.join(out_dir, name + ".json"),
+                                   shallow=False):
+                    sys.exit(f"{name}: batch output differs from the per-process output")
+            print(f"{'batch':>10} {threads:>8} {seconds:>9.3f} {len(names) / seconds:>9.1f} "
+                  f"{loop_seconds / seconds:>7.2f}x")
+    finally:
+        shutil.rmtree(workdir)
+
+
+if __name__ == "__main__":
+    main()
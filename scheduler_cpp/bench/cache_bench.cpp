@@ -0,0 +1,158 @@
+// 调度结果缓存在重复请求流上的效果。
+//
+//     make bench/cache_bench && ./bench/cache_bench [requests=1000] [distinct=100] [capacity=32] [zipf=1.0]
+//
+// distinct 个不同结构的 DAG（500–3000 个任务）按 Zipf 分布组成请求流，每个请求的任务名带有
+// 各自的前缀（结构相同、名字不同，命中后按本次的名字输出）。依次测量：不用缓存、只用内存层、
+// 内存层为 0 且磁盘层已预热（相当于进程重启后）。每个请求都经过完整的 ScheduleServer::schedule
+// （解析、转换、规划、输出），并校验带缓存的输出与不带缓存的逐字节相同。
+#include "../include/ScheduleServer.hpp"
+#include "../include/HardwareDescription.hpp"
+#include "../include/JsonStream.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::string makePayload(int taskCount, unsigned seed, const std::string& prefix) {
+    std::mt19937 rng(seed);
+    std::vector<std::vector<int>> parents(taskCount);
+    for (int v = 1; v < taskCount; ++v) {
+        int window = std::min(v, 32);
+        for (int k = 0; k < 2; ++k) {
+            parents[v].push_back(v - 1 - static_cast<int>(rng() % window));
+        }
+    }
+    std::string text;
+    JsonStream out(text, nullptr, false);
+    out.beginArray();
+    for (int v = 0; v < taskCount; ++v) {
+        std::string name = prefix + std::to_string(v);
+        out.beginObject();
+        out.key("taskId"); out.value(name);
+        out.key("computationCost"); out.value(1.0 + static_cast<double>(rng() % 1000) / 100.0);
+        out.key("spm_size"); out.value(1LL);
+        out.key("num_lane"); out.value(1LL);
+        out.key("has_bitalu"); out.value(false);
+        out.key("has_serdiv"); out.value(false);
+        out.key("has_complexunit"); out.value(false);
+        for (const char* field : {"text_offset", "data_offset", "total_length", "text_length", "data_length",
+                                  "output_num"}) {
+            out.key(field); out.value(0LL);
+        }
+        out.key("hardwareinfo"); out.value("0b00000");
+        out.key("hash"); out.value(name);
+        out.key("parentTasks");
+        out.beginArray();
+        for (int parent : parents[v]) {
+            out.beginObject();
+            out.key("taskId"); out.value(prefix + std::to_string(parent));
+            out.key("outputIndex"); out.value(0LL);
+            out.key("outputVar"); out.value("v");
+            out.key("concat_value"); out.value(0LL);
+            out.key("dest_address"); out.value("0x100000");
+            out.endObject();
+        }
+        out.endArray();
+        for (const char* field : {"childTasks", "global_Input", "para_Input", "return_output"}) {
+            out.key(field); out.beginArray(); out.endArray();
+        }
+        out.endObject();
+    }
+    out.endArray();
+    return text;
+}
+
+struct Request {
+    int dag;
+    std::string payload;
+};
+
+double runStream(const std::vector<Request>& requests, const std::shared_ptr<const HardwareDescription>& hardware,
+                 ScheduleCache* cache, std::vector<std::string>* outputs) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        std::string output = ScheduleServer::schedule(requests[i].payload, hardware, cache);
+        if (outputs->size() <= i) {
+            outputs->push_back(std::move(output));
+        } else if ((*outputs)[i] != output) {
+            std::fprintf(stderr, "cached output differs at request %zu\n", i);
+            std::exit(1);
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void report(const char* name, double seconds, std::size_t requests, const ScheduleCache* cache) {
+    std::printf("%-10s %9.2f s %9.1f req/s", name, seconds, requests / seconds);
+    if (cache != nullptr) {
+        ScheduleCache::Stats stats = cache->stats();
+        std::printf("  hits=%llu (disk %llu) misses=%llu evictions=%llu",
+                    static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.diskHits),
+                    static_cast<unsigned long long>(stats.misses), static_cast<unsigned long long>(stats.evictions));
+    }
+    std::printf("\n");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int requestCount = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int distinct = argc > 2 ? std::atoi(argv[2]) : 100;
+    std::size_t capacity = argc > 3 ? std::atoi(argv[3]) : 32;
+    double zipf = argc > 4 ? std::atof(argv[4]) : 1.0;
+
+    std::vector<double> weights(distinct);
+    for (int k = 0; k < distinct; ++k) {
+        weights[k] = 1.0 / std::pow(k + 1, zipf);
+    }
+    std::mt19937 rng(1);
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::vector<int> sizes(distinct);
+    for (int k = 0; k < distinct; ++k) {
+        sizes[k] = 500 + static_cast<int>(rng() % 2501);
+    }
+    std::vector<Request> requests;
+    std::vector<char> seen(distinct, 0);
+    int repeats = 0;
+    for (int i = 0; i < requestCount; ++i) {
+        int dag = pick(rng);
+        repeats += seen[dag];
+        seen[dag] = 1;
+        requests.push_back({dag, makePayload(sizes[dag], dag + 1, "r" + std::to_string(i) + "_t")});
+    }
+    std::printf("requests=%d distinct=%d capacity=%zu zipf=%.2f repeat ratio=%.1f%%\n", requestCount, distinct,
+                capacity, zipf, 100.0 * repeats / requestCount);
+
+    // 任务代价不超过 11，TILE 容量需不小于代价，否则任务在所有 TILE 上都不可行
+    std::vector<Tile> tiles;
+    for (int p = 0; p < 3; ++p) {
+        tiles.push_back({p, 100.0 * (1.0 + p % 4), 1, 1, false, false, false});
+    }
+    auto hardware = std::make_shared<const HardwareDescription>(tiles, MeshTopology());
+    std::vector<std::string> outputs;
+    report("no cache", runStream(requests, hardware, nullptr, &outputs), requests.size(), nullptr);
+
+    ScheduleCache memory(capacity);
+    report("memory", runStream(requests, hardware, &memory, &outputs), requests.size(), &memory);
+
+    char directory[] = "/tmp/cache_benchXXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    {
+        ScheduleCache warm(0, directory);
+        runStream(requests, hardware, &warm, &outputs);
+    }
+    ScheduleCache disk(0, directory);
+    report("disk", runStream(requests, hardware, &disk, &outputs), requests.size(), &disk);
+    std::string cleanup = std::string("rm -rf ") + directory;
+    return std::system(cleanup.c_str()) == 0 ? 0 : 1;
+}
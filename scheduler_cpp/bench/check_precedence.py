@@ -0,0 +1,128 @@
+"""
+main.py 形状输入的调度结果检查：每条边的子任务开始不早于父任务完成，开始/完成周期都不为负。
+
+    python3 bench/check_precedence.py [--exe ./main] [--dags 50] [--nodes 200] [--cores 2 16 64]
+
+随机分层 DAG（另加一条 4 个任务的链）经 main.py 的 convert_resources_to_hardware / convert_dag_to_heft_input
+转换后，通过 SchedulerClient 发送到 main --serve，与 main.py 的常驻服务路径相同。需要 requirements.txt 中的依赖。
+已 make python 时还用 heft_native.plan（main.py 的进程内路径）规划同一 DAG，校验两种后端的 core_id 与开始/完成周期相同。
+发现违例或不一致时逐条打印并以状态 1 退出。
+"""
+import argparse
+import asyncio
+import json
+import os
+import random
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+import main as service  # noqa: E402
+from scheduler_client import SchedulerClient, start_scheduler_daemon, stop_scheduler_daemon  # noqa: E402
+
+
+def make_dag(nodes, rng):
+    """随机分层 DAG；nodes 为 0 时为链 n0 -> n1 -> n2 -> n3"""
+    if nodes == 0:
+        ids = [f"n{i}" for i in range(4)]
+        edges = [(ids[i], ids[i + 1]) for i in range(3)]
+    else:
+        ids = [f"n{i}" for i in range(nodes)]
+        edges = []
+        for v in range(1, nodes):
+            for u in rng.sample(range(max(0, v - 16), v), min(v, rng.randint(1, 3))):
+                edges.append((ids[u], ids[v]))
+    return service.DAG.model_validate({
+        "nodes": [{"id": i, "name": i, "sourceFile": f"{i}.c"} for i in ids],
+        "edges": [{"fromNode": u, "toNode": v, "dataSize": rng.randint(0, 64)} for u, v in edges],
+    })
+
+
+def make_resources(cores):
+    return service.Resources.model_validate({
+        "cores": [{"id": i, "type": "generic"} for i in range(cores)],
+        "memorySizeKb": 256,
+    })
+
+
+def violations(dag, output):
+    """返回 (描述, ...) 列表；output 为调度器输出的 JSON"""
+    events = {task["debug_task_name"]: task for task in output[:-1]}
+    problems = []
+    for name, task in events.items():
+        if task["start_cycle"] < 0 or task["finish_cycle"] < 0:
+            problems.append(f"{name}: start {task['start_cycle']} finish {task['finish_cycle']}")
+    for edge in dag.edges:
+        parent, child = events[edge.from_node], events[edge.to_node]
+        if child["start_cycle"] < parent["finish_cycle"]:
+            problems.append(f"{edge.from_node} -> {edge.to_node}: child starts at {child['start_cycle']}, "
+                            f"parent finishes at {parent['finish_cycle']}")
+    return problems
+
+
+def load_native():
+    """已 make python 时返回 heft_native 模块，否则为 None"""
+    sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    try:
+        import heft_native
+    except ImportError:
+        return None
+    return heft_native
+
+
+def native_mismatches(native, dag, hardware, planner, output):
+    """与 main.py 进程内路径的结果逐任务比较"""
+    task_ids, costs, edge_source, edge_target, edge_bytes = service.convert_dag_to_native_arrays(dag)
+    plan = native.plan(costs, edge_source, edge_target, planner=planner, edge_bytes=edge_bytes,
+                       hardware=json.dumps(hardware))
+    daemon = {task["debug_task_name"]: (task["core_id"], task["start_cycle"], task["finish_cycle"])
+              for task in output[:-1]}
+    return [f"{task_ids[task]}: daemon {daemon[task_ids[task]]}, native {(core_id, start, finish)}"
+            for task, core_id, start, finish in plan if daemon[task_ids[task]] != (core_id, start, finish)]
+
+
+async def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--exe", default="./main")
+    parser.add_argument("--dags", type=int, default=50)
+    parser.add_argument("--nodes", type=int, default=200)
+    parser.add_argument("--cores", nargs="+", type=int, default=[2, 16, 64])
+    parser.add_argument("--planners", nargs="+", choices=("heft", "peft"), default=["heft", "peft"])
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    native = load_native()
+    if native is None:
+        print("heft_native not built (make python); skipping the daemon/native comparison")
+    rng = random.Random(args.seed)
+    dags = [make_dag(0, rng)] + [make_dag(args.nodes, rng) for _ in range(args.dags)]
+    failed = 0
+    with tempfile.TemporaryDirectory() as workdir:
+        socket_path = os.path.join(workdir, "scheduler.sock")
+        process = await start_scheduler_daemon(args.exe, socket_path)
+        client = SchedulerClient(socket_path)
+        try:
+            for cores in args.cores:
+                resources = make_resources(cores)
+                hardware = service.convert_resources_to_hardware(resources)
+                for planner in args.planners:
+                    for index, dag in enumerate(dags):
+                        heft_input = service.convert_dag_to_heft_input(dag, resources)
+                        output = await client.schedule(heft_input, planner, hardware)
+                        problems = violations(dag, output)
+                        if native is not None:
+                            problems += native_mismatches(native, dag, hardware, planner, output)
+                        for problem in problems:
+                            failed += 1
+                            print(f"cores={cores} planner={planner} dag={index}: {problem}")
+                print(f"cores={cores}: {len(dags)} DAGs x {len(args.planners)} planners checked", flush=True)
+        finally:
+            await client.close()
+            await stop_scheduler_daemon(process, socket_path)
+    if failed:
+        print(f"{failed} problem(s)")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
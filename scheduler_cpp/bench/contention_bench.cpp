@@ -0,0 +1,151 @@
+// 链路竞争模式的规划耗时，以及解析代价下的计划在链路竞争下实际能达到的 makespan。
+//
+//     make bench/contention_bench && ./bench/contention_bench [tiles=16] [bandwidth=16] [sizes...=1000 10000 50000]
+//
+// 随机分层 DAG，每个任务 2–4 条入边，边的字节数在 1–32 之间（任务执行时间不超过 1 个周期，与之相当）。
+// 分别用解析代价（CommModel）与链路竞争模式（LinkSchedule）规划，再把两份计划放到带链路预约的网络上重放：
+// 保持每个任务的 TILE，按规划器的分配顺序预约入边传输（与 bookTransfers 相同，先完成的父任务先预约），
+// 再在该 TILE 的时间线上放置任务。planned 为规划给出的 makespan，replayed 为重放得到的 makespan；
+// 链路竞争模式下两者以及每个任务的开始、完成时间须完全相同。
+#include "../include/HEFTPlanningAlgorithm.hpp"
+#include "../include/LinkSchedule.hpp"
+#include "../include/TaskConverter.hpp"
+#include "../include/TileTimeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+std::vector<Task> makeTasks(int count, std::mt19937& rng, int& edgeCount) {
+    std::uniform_real_distribution<double> cost(1.0, 100.0);
+    std::vector<double> costs(count);
+    std::vector<int> ones(count, 1);
+    std::vector<int> none(count, 0);
+    std::vector<int> sources;
+    std::vector<int> targets;
+    std::vector<int> bytes;
+    for (int v = 0; v < count; ++v) {
+        costs[v] = cost(rng);
+        int parents = v > 0 ? 2 + static_cast<int>(rng() % 3) : 0;
+        for (int k = 0; k < parents; ++k) {
+            int window = std::min(v, 256);
+            sources.push_back(v - 1 - static_cast<int>(rng() % window));
+            targets.push_back(v);
+            bytes.push_back(1 + static_cast<int>(rng() % 32));
+        }
+    }
+    edgeCount = static_cast<int>(sources.size());
+    return TaskConverter::buildTasks(count, costs.data(), ones.data(), ones.data(), none.data(), edgeCount,
+                                     sources.data(), targets.data(), bytes.data());
+}
+
+// 公开分配顺序供重放使用
+class Planner : public HEFTPlanningAlgorithm {
+public:
+    using HEFTPlanningAlgorithm::HEFTPlanningAlgorithm;
+
+    const std::vector<int>& getAllocationOrder() const { return allocationOrder; }
+};
+
+// 返回重放的 makespan；events 为重放得到的各任务时间
+double replay(const Planner& planner, const CommModel& contended, std::vector<Event>& events) {
+    const TaskGraph& dag = planner.getTaskGraph();
+    events = planner.getTaskEvents();
+
+    // 基准中 tileId 即 TILE 下标
+    LinkSchedule links;
+    links.reset(contended);
+    std::vector<TileTimeline> timelines(dag.numTiles);
+    std::vector<std::pair<double, int>> incoming;
+    double makespan = 0.0;
+    for (int taskId : planner.getAllocationOrder()) {
+        int tile = events[taskId].tileId;
+        incoming.clear();
+        for (int e = dag.parentOffsets[taskId]; e < dag.parentOffsets[taskId + 1]; ++e) {
+            incoming.push_back({events[dag.parentIds[e]].finish, e});
+        }
+        std::sort(incoming.begin(), incoming.end());
+        double ready = 0.0;
+        for (const auto& transfer : incoming) {
+            int e = transfer.second;
+            ready = std::max(ready, links.book(events[dag.parentIds[e]].tileId, tile, transfer.first, dag.parentBytes[e]));
+        }
+        double cost = dag.computationCost(taskId, tile);
+        double start = timelines[tile].earliestStart(ready, cost);
+        timelines[tile].occupy(start, start + cost);
+        events[taskId].start = start;
+        events[taskId].finish = start + cost;
+        makespan = std::max(makespan, events[taskId].finish);
+    }
+    return makespan;
+}
+
+bool sameTimes(const std::vector<Event>& a, const std::vector<Event>& b) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].start != b[i].start || a[i].finish != b[i].finish) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+int main(int argc, char* argv[]) {
+    int tileCount = argc > 1 ? std::atoi(argv[1]) : 16;
+    double bandwidth = argc > 2 ? std::atof(argv[2]) : 16.0;
+    std::vector<int> sizes;
+    for (int i = 3; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 50000};
+    }
+
+    std::vector<Tile> tiles;
+    for (int p = 0; p < tileCount; ++p) {
+        tiles.push_back({p, 100.0 * (1.0 + p % 4), 1, 1, false, false, false});
+    }
+    MeshTopology mesh;
+    mesh.linkBandwidth = bandwidth;
+    auto analytic = std::make_shared<const CommModel>(tiles, mesh);
+    mesh.contention = true;
+    auto contended = std::make_shared<const CommModel>(tiles, mesh);
+
+    std::printf("tiles=%d mesh=%dx%d bandwidth=%g\n", tileCount, contended->topology().columns, contended->rows(),
+                bandwidth);
+    std::printf("%8s %8s %11s %10s %12s %12s %9s\n", "tasks", "edges", "mode", "plan_ms", "planned", "replayed",
+                "gap");
+    std::mt19937 rng(1);
+    for (int size : sizes) {
+        int edgeCount = 0;
+        std::vector<Task> tasks = makeTasks(size, rng, edgeCount);
+        for (const auto& model : {analytic, contended}) {
+            Planner planner(tasks, tiles, model);
+            auto begin = std::chrono::steady_clock::now();
+            planner.run();
+            double planMs = elapsedMs(begin);
+            double planned = planner.getMakespan();
+            std::vector<Event> replayedEvents;
+            double replayed = replay(planner, *contended, replayedEvents);
+            if (model->topology().contention &&
+                (replayed != planned || !sameTimes(planner.getTaskEvents(), replayedEvents))) {
+                std::fprintf(stderr, "tasks=%d: contention plan differs from its replay (%.17g vs %.17g)\n", size,
+                             planned, replayed);
+                return 1;
+            }
+            std::printf("%8d %8d %11s %10.2f %12.1f %12.1f %8.1f%%\n", size, edgeCount,
+                        model->topology().contention ? "contention" : "analytic", planMs, planned, replayed,
+                        100.0 * (replayed - planned) / planned);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+"""
+常驻服务与逐请求 fork 的延迟/吞吐对比。
+
+    python3 bench/daemon_bench.py [--exe ./main] [--nodes 200] [--requests 400] [--concurrency 8]
+
+fork 模式复现 main.py 原先的做法：在 async 处理函数里写临时文件、subprocess.run、读回输出；
+daemon 模式通过 SchedulerClient 发送到 main --serve。两者输入与硬件描述相同，报告 p50/p99 与每秒请求数。
+"""
+import argparse
+import asyncio
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+from scheduler_client import SchedulerClient, start_scheduler_daemon, stop_scheduler_daemon  # noqa: E402
+
+
+# 与内置硬件相同的 3 个 TILE，但算力不小于任务代价（内置 TILE 的算力为 1，代价 50–150 的任务在其上不可执行）
+HARDWARE = {"tiles": [
+    {"tileId": i, "computationCapacity": 150, "spm_size": 1, "num_lane": 1,
+     "has_bitalu": False, "has_serdiv": False, "has_complexunit": False}
+    for i in range(3)
+]}
+
+
+def make_heft_input(nodes, seed):
+    """与 main.py convert_dag_to_heft_input 相同形状的随机分层 DAG"""
+    rng = random.Random(seed)
+    ids = [f"n{i}" for i in range(nodes)]
+    parents = {i: [] for i in ids}
+    children = {i: [] for i in ids}
+    for v in range(1, nodes):
+        for u in rng.sample(range(max(0, v - 16), v), min(v, rng.randint(1, 3))):
+            var = f"data_from_{ids[u]}_to_{ids[v]}"
+            parents[ids[v]].append({"taskId": ids[u], "outputIndex": 0, "outputVar": var,
+                                    "concat_value": 0, "dest_address": "null",
+                                    "slice_length": str(rng.randint(0, 64)), "slice_data_type": "1"})
+            children[ids[u]].append({"taskId": ids[v], "inputIndex": 0, "inputVar": var, "concat_value": 0})
+    return [{
+        "taskId": i, "computationCost": rng.randint(50, 150), "spm_size": 1, "num_lane": 1,
+        "has_bitalu": 0, "has_serdiv": 0, "has_complexunit": 0, "text_offset": "0x0", "data_offset": "0x0",
+        "total_length": 0, "text_length": 0, "data_length": 0, "output_num": len(children[i]),
+        "hardwareinfo": "0x0", "hash": "0x0", "parentTasks": parents[i], "childTasks": children[i],
+        "global_Input": [], "para_Input": [], "return_output": [],
+    } for i in ids]
+
+
+def fork_request(exe, workdir, hardware_path, heft_input, index):
+    input_path = os.path.join(workdir, f"{index}_input.json")
+    output_path = os.path.join(workdir, f"{index}_output.json")
+    with open(input_path, "w") as f:
+        json.dump(heft_input, f, indent=2)
+    subprocess.run([exe, input_path, output_path, "--hardware", hardware_path], capture_output=True, text=True,
+                   check=True)
+    with open(output_path) as f:
+        output = json.load(f)
+    os.remove(input_path)
+    os.remove(output_path)
+    return output
+
+
+async def run_load(handler, inputs, concurrency):
+    latencies = []
+    queue = list(enumerate(inputs))
+
+    async def worker():
+        while queue:
+            index, heft_input = queue.pop()
+            start = time.perf_counter()
+            await handler(index, heft_input)
+            latencies.append(time.perf_counter() - start)
+
+    start = time.perf_counter()
+    await asyncio.gather(*(worker() for _ in range(concurrency)))
+    return latencies, time.perf_counter() - start
+
+
+def report(name, latencies, elapsed):
+    latencies.sort()
+    p50 = latencies[len(latencies) // 2] * 1e3
+    p99 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.99))] * 1e3
+    print(f"{name:8s} requests={len(latencies)} p50={p50:.2f}ms p99={p99:.2f}ms "
+          f"throughput={len(latencies) / elapsed:.1f} req/s")
+
+
+async def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--exe", default="./main")
+    parser.add_argument("--nodes", type=int, default=200)
+    parser.add_argument("--requests", type=int, default=400)
+    parser.add_argument("--concurrency", type=int, default=8)
+    parser.add_argument("--threads", type=int, default=os.cpu_count() or 1)
+    args = parser.parse_args()
+
+    exe = os.path.abspath(args.exe)
+    inputs = [make_heft_input(args.nodes, seed) for seed in range(args.requests)]
+
+    with tempfile.TemporaryDirectory() as workdir:
+        hardware_path = os.path.join(workdir, "hardware.json")
+        with open(hardware_path, "w") as f:
+            json.dump(HARDWARE, f)
+
+        # 与原 main.py 一致：阻塞调用直接发生在事件循环线程上
+        async def fork_handler(index, heft_input):
+            fork_request(exe, workdir, hardware_path, heft_input, index)
+
+        latencies, elapsed = await run_load(fork_handler, inputs, args.concurrency)
+        report("fork", latencies, elapsed)
+
+        socket_path = os.path.join(workdir, "scheduler.sock")
+        process = await start_scheduler_daemon(exe, socket_path, args.threads)
+        client = SchedulerClient(socket_path, max_connections=args.concurrency)
+        try:
+            async def daemon_handler(index, heft_input):
+                await client.schedule(heft_input, None, HARDWARE)
+
+            latencies, elapsed = await run_load(daemon_handler, inputs, args.concurrency)
+            report("daemon", latencies, elapsed)
+        finally:
+            await client.close()
+            await stop_scheduler_daemon(process, socket_path)
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
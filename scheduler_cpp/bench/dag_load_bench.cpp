@@ -0,0 +1,142 @@
+// JSON 与 .dag 输入的加载耗时对比。
+//
+//     make bench/dag_load_bench && ./bench/dag_load_bench [tasks...]（默认 100000 300000 1000000）
+//
+// 每个规模生成一个随机 DAG 的 JSON（slice_updated_tasks.json 的格式，每个任务 2 条父边），转换为 .dag，
+// 然后分别测量从文件到可以开始规划的 TaskGraph 所需的时间（各取 3 次中的最小值，文件已在页缓存中）：
+//   json  JsonParser::parseJsonStream + TaskConverter::convertToTasks + TaskGraph::build
+//   dag   DagFile（mmap + 校验）+ TaskGraph::build
+// 并校验两者得到的 TaskGraph 相同。
+#include "../include/DagFile.hpp"
+#include "../include/HardwareDescription.hpp"
+#include "../include/JsonParser.hpp"
+#include "../include/JsonStream.hpp"
+#include "../include/TaskConverter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+void writeJson(const std::string& path, int taskCount, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::string buffer;
+    JsonStream out(buffer, &file, false);
+    out.beginArray();
+    for (int v = 0; v < taskCount; ++v) {
+        std::string name = "t" + std::to_string(v);
+        out.beginObject();
+        out.key("taskId"); out.value(name);
+        out.key("computationCost"); out.value(1.0 + static_cast<double>(rng() % 1000) / 100.0);
+        out.key("spm_size"); out.value(1LL);
+        out.key("num_lane"); out.value(1LL);
+        out.key("has_bitalu"); out.value(false);
+        out.key("has_serdiv"); out.value(false);
+        out.key("has_complexunit"); out.value(false);
+        for (const char* field : {"text_offset", "data_offset", "total_length", "text_length", "data_length",
+                                  "output_num"}) {
+            out.key(field); out.value(static_cast<long long>(rng() % 4096));
+        }
+        out.key("hardwareinfo"); out.value("0b00000");
+        out.key("hash"); out.value("h" + std::to_string(rng()));
+        out.key("parentTasks");
+        out.beginArray();
+        for (int k = 0; k < 2 && v > 0; ++k) {
+            int window = std::min(v, 64);
+            out.beginObject();
+            out.key("taskId"); out.value("t" + std::to_string(v - 1 - static_cast<int>(rng() % window)));
+            out.key("outputIndex"); out.value(static_cast<long long>(k));
+            out.key("outputVar"); out.value("v" + std::to_string(k));
+            out.key("concat_value"); out.value(0LL);
+            out.key("dest_address"); out.value("0x100000");
+            out.endObject();
+        }
+        out.endArray();
+        for (const char* field : {"childTasks", "global_Input", "para_Input", "return_output"}) {
+            out.key(field); out.beginArray(); out.endArray();
+        }
+        out.endObject();
+    }
+    out.endArray();
+    out.flush();
+}
+
+long long fileSize(const std::string& path) {
+    struct stat info;
+    return ::stat(path.c_str(), &info) == 0 ? static_cast<long long>(info.st_size) : -1;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+bool sameGraph(const TaskGraph& a, const TaskGraph& b) {
+    return a.numTasks == b.numTasks && a.parentOffsets == b.parentOffsets && a.parentIds == b.parentIds &&
+           a.childIds == b.childIds && a.computationCosts == b.computationCosts && a.taskClass == b.taskClass;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {100000, 300000, 1000000};
+    }
+    char directory[] = "/tmp/dag_load_benchXXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    const std::vector<Tile>& tiles = HardwareDescription::builtin()->tiles();
+
+    std::printf("%8s %10s %10s %10s %10s %8s\n", "tasks", "json MB", "dag MB", "json ms", "dag ms", "speedup");
+    for (int taskCount : sizes) {
+        std::string jsonPath = std::string(directory) + "/dag" + std::to_string(taskCount) + ".json";
+        std::string dagPath = std::string(directory) + "/dag" + std::to_string(taskCount) + ".dag";
+        writeJson(jsonPath, taskCount, taskCount);
+        {
+            StringPool pool;
+            DagFile::write(dagPath, JsonParser::parseJsonStream(jsonPath, pool), pool);
+        }
+
+        double jsonMs = 1e300;
+        double dagMs = 1e300;
+        TaskGraph fromJson;
+        TaskGraph fromDag;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            {
+                auto begin = std::chrono::steady_clock::now();
+                StringPool pool;
+                std::vector<inputTask> inputTasks = JsonParser::parseJsonStream(jsonPath, pool);
+                auto converted = TaskConverter::convertToTasks(inputTasks);
+                TaskGraph::build(converted.first, tiles, fromJson, std::pmr::get_default_resource());
+                jsonMs = std::min(jsonMs, elapsedMs(begin));
+            }
+            {
+                auto begin = std::chrono::steady_clock::now();
+                DagFile file(dagPath);
+                TaskGraph::build(file, tiles, fromDag, std::pmr::get_default_resource());
+                dagMs = std::min(dagMs, elapsedMs(begin));
+            }
+        }
+        if (!sameGraph(fromJson, fromDag)) {
+            std::fprintf(stderr, "task graphs differ at %d tasks\n", taskCount);
+            return 1;
+        }
+        std::printf("%8d %10.1f %10.1f %10.1f %10.1f %7.1fx\n", taskCount, fileSize(jsonPath) / 1048576.0,
+                    fileSize(dagPath) / 1048576.0, jsonMs, dagMs, jsonMs / dagMs);
+        std::remove(jsonPath.c_str());
+        std::remove(dagPath.c_str());
+    }
+    ::rmdir(directory);
+    return 0;
+}
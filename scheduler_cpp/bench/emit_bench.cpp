@@ -0,0 +1,199 @@
+// 调度结果两种输出方式的吞吐与峰值内存对比。
+//
+//     make bench/emit_bench && ./bench/emit_bench [tasks...]（默认 10000 100000）
+//
+// 每个规模生成一个随机 DAG 的 JSON（父/子边、global_Input、para_Input 与 return_output 都有），
+// 用 parseJsonStream 读入后以合成的 rank 与分配结果分别输出：
+//   dom     ScheduleEmitter::buildOutput(...).dump(4) 写入文件
+//   stream  ScheduleEmitter::writeOutput 经 JsonStream（pretty）直接写入文件
+// 每种方式在单独 fork 出的子进程中运行，峰值 RSS 取自 wait4 返回的子进程 ru_maxrss；base 为只读入输入、
+// 不做输出的子进程的峰值 RSS。耗时只计输出，取子进程内 3 次中的最小值。
+// 两种方式的输出须逐字节相同（在子进程中比较）。
+#include "../include/JsonParser.hpp"
+#include "../include/ScheduleEmitter.hpp"
+#include "../include/TaskConverter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+enum class Mode { Base, Dom, Stream, Compare };
+
+void writeJson(const std::string& path, int taskCount, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << '[';
+    for (int v = 0; v < taskCount; ++v) {
+        file << (v == 0 ? "" : ",") << "{\"taskId\":\"t" << v << "\",\"computationCost\":"
+             << 1.0 + static_cast<double>(rng() % 1000) / 100.0
+             << ",\"spm_size\":1,\"num_lane\":1,\"has_bitalu\":false,\"has_serdiv\":false,\"has_complexunit\":false";
+        for (const char* field : {"text_offset", "data_offset", "total_length", "text_length", "data_length"}) {
+            file << ",\"" << field << "\":" << rng() % 4096;
+        }
+        file << ",\"output_num\":2,\"hardwareinfo\":\"0b00000\",\"hash\":\"h" << rng() << "\",\"parentTasks\":[";
+        for (int k = 0; k < 2 && v > 0; ++k) {
+            int window = std::min(v, 64);
+            file << (k == 0 ? "" : ",") << "{\"taskId\":\"t" << v - 1 - static_cast<int>(rng() % window)
+                 << "\",\"outputIndex\":" << k << ",\"outputVar\":\"v" << k << "\",\"concat_value\":0"
+                 << ",\"dest_address\":\"0x" << std::hex << 0x100000 + 0x40 * k << std::dec
+                 << "\",\"slice_length\":\"16\",\"slice_data_type\":\"4\"}";
+        }
+        file << "],\"childTasks\":[{\"taskId\":\"t" << v + 1 << "\",\"inputIndex\":0,\"inputVar\":\"in0\""
+             << ",\"concat_value\":0,\"slice_length\":\"16\",\"slice_data_type\":\"4\"}]"
+             << ",\"global_Input\":[{\"name\":\"g" << v % 16 << "\",\"dest_address\":\"0x200000\"}]"
+             << ",\"para_Input\":[{\"name\":\"p" << v % 8 << "\",\"dest_address\":\"0x300000\""
+             << ",\"slice_length\":\"8\",\"slice_data_type\":\"4\"}]"
+             << ",\"return_output\":[";
+        if (v % 100 == 0) {
+            file << "{\"name\":\"r" << v << "\",\"index\":0}";
+        }
+        file << "]}\n";
+    }
+    file << "]\n";
+}
+
+long long fileSize(const std::string& path) {
+    struct stat info;
+    return ::stat(path.c_str(), &info) == 0 ? static_cast<long long>(info.st_size) : -1;
+}
+
+// 读入的任务与合成的调度结果：rank 按下标递减，任务轮流放在 4 个 TILE 上
+struct Input {
+    StringPool pool;
+    std::vector<inputTask> tasks;
+    std::unordered_map<Symbol, int> idMapping;
+    std::vector<std::pair<int, double>> ranks;
+    std::vector<Event> events;
+
+    explicit Input(const std::string& path) {
+        tasks = JsonParser::parseJsonStream(path, pool);
+        idMapping = TaskConverter::convertToTasks(tasks).second;
+        int count = static_cast<int>(tasks.size());
+        for (int v = 0; v < count; ++v) {
+            ranks.push_back({v, static_cast<double>(count - v)});
+            events.push_back({v, v % 4, static_cast<double>(v), v + 1.5});
+        }
+    }
+};
+
+void emit(Mode mode, const Input& input, std::ostream& sink) {
+    if (mode == Mode::Dom) {
+        sink << ScheduleEmitter::buildOutput(input.tasks, input.pool, input.idMapping, input.ranks, input.events)
+                    .dump(4);
+        return;
+    }
+    std::string buffer;
+    JsonStream out(buffer, &sink, true);
+    ScheduleEmitter::writeOutput(out, input.tasks, input.pool, input.idMapping, input.ranks, input.events);
+}
+
+bool sameOutput(const Input& input) {
+    std::ostringstream dom;
+    std::ostringstream stream;
+    emit(Mode::Dom, input, dom);
+    emit(Mode::Stream, input, stream);
+    return dom.str() == stream.str();
+}
+
+struct Measurement {
+    double ms = 0.0;
+    double peakMb = 0.0;
+    long long bytes = 0;
+};
+
+// 在子进程中读入并输出，耗时与输出大小经管道传回
+Measurement measure(Mode mode, const std::string& path) {
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+    pid_t child = ::fork();
+    if (child < 0) {
+        std::perror("fork");
+        std::exit(1);
+    }
+    if (child == 0) {
+        ::close(fds[0]);
+        Measurement result;
+        Input input(path);
+        if (mode == Mode::Compare && !sameOutput(input)) {
+            std::fprintf(stderr, "dom and stream outputs differ for %s\n", path.c_str());
+            ::_exit(1);
+        }
+        if (mode == Mode::Dom || mode == Mode::Stream) {
+            std::string outputPath = path + ".out";
+            result.ms = 1e300;
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                auto begin = std::chrono::steady_clock::now();
+                {
+                    std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+                    emit(mode, input, file);
+                }
+                result.ms = std::min(result.ms, std::chrono::duration<double, std::milli>(
+                                                    std::chrono::steady_clock::now() - begin).count());
+            }
+            result.bytes = fileSize(outputPath);
+            std::remove(outputPath.c_str());
+        }
+        bool written = ::write(fds[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+        ::_exit(written ? 0 : 1);
+    }
+    ::close(fds[1]);
+    Measurement result;
+    bool received = ::read(fds[0], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+    ::close(fds[0]);
+    int status = 0;
+    struct rusage usage;
+    if (::wait4(child, &status, 0, &usage) != child || !received || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::fprintf(stderr, "emit for %s failed\n", path.c_str());
+        std::exit(1);
+    }
+    result.peakMb = usage.ru_maxrss / 1024.0;
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {10000, 100000};
+    }
+    char directory[] = "/tmp/emit_benchXXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+
+    std::printf("%8s %8s %9s %10s %10s %11s %8s %10s %11s\n", "tasks", "out MB", "dom ms", "stream ms", "dom MB/s",
+                "stream MB/s", "base MB", "dom RSS MB", "stream RSS");
+    for (int taskCount : sizes) {
+        std::string jsonPath = std::string(directory) + "/dag" + std::to_string(taskCount) + ".json";
+        writeJson(jsonPath, taskCount, taskCount);
+        measure(Mode::Compare, jsonPath);
+        Measurement base = measure(Mode::Base, jsonPath);
+        Measurement dom = measure(Mode::Dom, jsonPath);
+        Measurement stream = measure(Mode::Stream, jsonPath);
+        double megabytes = stream.bytes / 1048576.0;
+        std::printf("%8d %8.1f %9.1f %10.1f %10.1f %11.1f %8.1f %10.1f %11.1f\n", taskCount, megabytes, dom.ms,
+                    stream.ms, megabytes / (dom.ms / 1e3), megabytes / (stream.ms / 1e3), base.peakMb, dom.peakMb,
+                    stream.peakMb);
+        std::remove(jsonPath.c_str());
+    }
+    ::rmdir(directory);
+    return 0;
+}
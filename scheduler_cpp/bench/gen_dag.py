@@ -0,0 +1,220 @@
+"""
+合成 DAG 生成器：输出 JsonParser 接受的任务数组，以及 main --hardware 使用的 TILE 集合。
+
+    python3 bench/gen_dag.py --shape fft --nodes 10000 --out dag.json [--tiles-out tiles.json]
+        [--tiles 8] [--tile-classes 2] [--heterogeneity 4] [--seed 1]
+
+形状：layered（分层随机）、forkjoin、fft、gaussian（高斯消元）、montage、random（Erdős–Rényi）。
+fft / gaussian / montage 的规模由参数决定，实际节点数取不超过 --nodes 的最大值。
+
+异构 TILE：--tile-classes 个能力类（spm_size / num_lane / 功能位不同），TILE 轮流分到各类；
+算力在 [cost_max, cost_max * heterogeneity] 内均匀取值，保证每个任务在本类所有 TILE 上都可执行。
+任务按 TILE 数占比随机分到能力类，计算代价在 [cost_min, cost_max] 内均匀取值。
+"""
+import argparse
+import json
+import math
+import random
+import sys
+
+SHAPES = ("layered", "forkjoin", "fft", "gaussian", "montage", "random")
+
+
+def layered_edges(n, rng, width=None, fan_in=3):
+    width = width or max(1, int(math.sqrt(n)))
+    edges = []
+    for v in range(width, n):
+        layer_start = (v // width) * width
+        prev_start = layer_start - width
+        for u in set(rng.randrange(prev_start, layer_start) for _ in range(rng.randint(1, fan_in))):
+            edges.append((u, v))
+    return n, edges
+
+
+def forkjoin_edges(n, rng, width=8):
+    # 源 -> width 个并行任务 -> 汇，汇作为下一段的源
+    stages = max(1, (n - 1) // (width + 1))
+    edges = []
+    source = 0
+    count = 1
+    for _ in range(stages):
+        sink = count + width
+        for k in range(count, count + width):
+            edges.append((source, k))
+            edges.append((k, sink))
+        source = sink
+        count = sink + 1
+    return count, edges
+
+
+def fft_edges(n, rng):
+    # m 点 FFT：2m-1 个递归调用任务（二叉树）+ log2(m) 层、每层 m 个蝶形任务
+    m = 2
+    while 2 * (2 * m) - 1 + (2 * m) * int(math.log2(2 * m)) <= n:
+        m *= 2
+    edges = []
+    tree = 2 * m - 1
+    for v in range(1, tree):
+        edges.append(((v - 1) // 2, v))
+    levels = int(math.log2(m))
+    leaf_start = m - 1
+    for level in range(levels):
+        base = tree + level * m
+        for i in range(m):
+            partner = i ^ (1 << level)
+            if level == 0:
+                edges.append((leaf_start + i, base + i))
+                edges.append((leaf_start + partner, base + i))
+            else:
+                prev = tree + (level - 1) * m
+                edges.append((prev + i, base + i))
+                edges.append((prev + partner, base + i))
+    return tree + levels * m, edges
+
+
+def gaussian_edges(n, rng):
+    # m×m 矩阵：第 k 步一个主元任务 + (m-1-k) 个更新任务，共 (m²+m-2)/2 个
+    m = 2
+    while ((m + 1) ** 2 + (m + 1) - 2) // 2 <= n:
+        m += 1
+    index = {}
+    for k in range(m - 1):
+        for j in range(k, m):
+            index[(k, j)] = len(index)
+    edges = []
+    for k in range(m - 1):
+        pivot = index[(k, k)]
+        for j in range(k + 1, m):
+            update = index[(k, j)]
+            edges.append((pivot, update))
+            if k + 1 < m - 1:
+                edges.append((update, index[(k + 1, j)]))
+    return len(index), edges
+
+
+def montage_edges(n, rng):
+    # mProjectPP(p) -> mDiffFit(d，每个依赖两张相邻图) -> mConcatFit -> mBgModel
+    # -> mBackground(p，依赖 mBgModel 与对应投影) -> mImgtbl -> mAdd -> mShrink -> mJPEG
+    p = max(2, (n - 6) // 4)
+    d = min(n - 2 * p - 6, p * (p - 1) // 2)
+    project = list(range(p))
+    diff = list(range(p, p + d))
+    concat = p + d
+    bg_model = concat + 1
+    background = list(range(bg_model + 1, bg_model + 1 + p))
+    imgtbl = bg_model + 1 + p
+    edges = []
+    for k, v in enumerate(diff):
+        offset = 1 + k // p
+        a = k % p
+        edges.append((project[a], v))
+        edges.append((project[(a + offset) % p], v))
+        edges.append((v, concat))
+    edges.append((concat, bg_model))
+    for i, v in enumerate(background):
+        edges.append((bg_model, v))
+        edges.append((project[i], v))
+        edges.append((v, imgtbl))
+    edges.append((imgtbl, imgtbl + 1))
+    edges.append((imgtbl + 1, imgtbl + 2))
+    edges.append((imgtbl + 2, imgtbl + 3))
+    return imgtbl + 4, edges
+
+
+def random_edges(n, rng, degree=3.0):
+    # G(n, p) 取下三角得到 DAG；按几何分布跳过未选中的点对，O(n + m)
+    prob = min(1.0, degree / max(1, n))
+    edges = []
+    if prob >= 1.0:
+        return n, [(u, v) for v in range(n) for u in range(v)]
+    log_q = math.log(1.0 - prob)
+    v, u = 1, -1
+    while v < n:
+        u += 1 + int(math.log(1.0 - rng.random()) / log_q)
+        while u >= v and v < n:
+            u -= v
+            v += 1
+        if v < n:
+            edges.append((u, v))
+    return n, edges
+
+
+GENERATORS = {
+    "layered": layered_edges,
+    "forkjoin": forkjoin_edges,
+    "fft": fft_edges,
+    "gaussian": gaussian_edges,
+    "montage": montage_edges,
+    "random": random_edges,
+}
+
+
+def make_tiles(count, classes, heterogeneity, cost_max, rng):
+    tiles = []
+    for t in range(count):
+        c = t % classes
+        tiles.append({
+            "tileId": t,
+            "computationCapacity": round(cost_max * rng.uniform(1.0, heterogeneity), 3),
+            "spm_size": 1 << c, "num_lane": 1 + c % 4,
+            "has_bitalu": bool(c & 1), "has_serdiv": bool(c & 2), "has_complexunit": bool(c & 4),
+        })
+    return tiles
+
+
+def write_dag(out, shape, nodes, tiles, rng, cost_min=1.0, cost_max=100.0):
+    """按 JsonParser 的输入格式逐任务写出，返回 (任务数, 边数)"""
+    count, edges = GENERATORS[shape](nodes, rng)
+    parents = [[] for _ in range(count)]
+    children = [[] for _ in range(count)]
+    for u, v in edges:
+        parents[v].append(u)
+        children[u].append(v)
+    classes = [(t["spm_size"], t["num_lane"], t["has_bitalu"], t["has_serdiv"], t["has_complexunit"]) for t in tiles]
+
+    out.write("[")
+    for i in range(count):
+        spm, lane, bitalu, serdiv, complexunit = rng.choice(classes)
+        task = {
+            "taskId": f"t{i}", "computationCost": round(rng.uniform(cost_min, cost_max), 3),
+            "spm_size": spm, "num_lane": lane,
+            "has_bitalu": bitalu, "has_serdiv": serdiv, "has_complexunit": complexunit,
+            "text_offset": 0, "data_offset": 0, "total_length": 0, "text_length": 0, "data_length": 0,
+            "output_num": len(children[i]), "hardwareinfo": "0b00000", "hash": "%08x" % i,
+            "parentTasks": [{"taskId": f"t{u}", "outputIndex": 0, "outputVar": f"v{u}", "concat_value": 0,
+                             "dest_address": "0x%X" % (0x100000 + 0x100 * (u % 4096))} for u in parents[i]],
+            "childTasks": [{"taskId": f"t{v}", "inputIndex": 0, "inputVar": f"v{i}", "concat_value": 0}
+                           for v in children[i]],
+            "global_Input": [], "para_Input": [], "return_output": [],
+        }
+        if i:
+            out.write(",")
+        out.write(json.dumps(task, separators=(",", ":")))
+    out.write("]")
+    return count, len(edges)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--shape", choices=SHAPES, default="layered")
+    parser.add_argument("--nodes", type=int, default=1000)
+    parser.add_argument("--out", required=True)
+    parser.add_argument("--tiles-out")
+    parser.add_argument("--tiles", type=int, default=8)
+    parser.add_argument("--tile-classes", type=int, default=2)
+    parser.add_argument("--heterogeneity", type=float, default=4.0)
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    tiles = make_tiles(args.tiles, min(args.tile_classes, args.tiles), args.heterogeneity, 100.0, rng)
+    if args.tiles_out:
+        with open(args.tiles_out, "w") as f:
+            json.dump(tiles, f, indent=1)
+    with open(args.out, "w") as f:
+        count, edge_count = write_dag(f, args.shape, args.nodes, tiles, rng)
+    print(f"{args.shape}: {count} tasks, {edge_count} edges -> {args.out}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
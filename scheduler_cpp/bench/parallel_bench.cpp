@@ -0,0 +1,108 @@
+// WorkerPool 并行评估各 TILE 的 EFT 与串行的耗时对比及结果一致性检查。
+//
+//     make bench/parallel_bench && ./bench/parallel_bench [tasks=5000] [threads...=2 4]
+//
+// 随机 DAG：每个任务 1–3 个父任务，取自前 64 个任务；TILE 数取 8/16/64/256，算力在 100/200/400 之间轮换。
+// 每个 TILE 数先串行 run()，再对每个线程数挂上 WorkerPool 运行，各任务的 TILE、开始与完成时间须与串行完全相同。
+// 耗时为 run() 整体（rank + 分配）取 3 次中的最小值；TILE 数少于 16 时并行路径不启用，两者应基本相同。
+#include "../include/HEFTPlanningAlgorithm.hpp"
+#include "../include/WorkerPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+void addEdge(std::vector<Task>& tasks, int parent, int child) {
+    PortEdge<int> edge{};
+    edge.taskId = parent;
+    tasks[child].parentTasks.push_back(edge);
+    edge.taskId = child;
+    tasks[parent].childTasks.push_back(edge);
+}
+
+std::vector<Task> makeTasks(int count) {
+    std::mt19937 rng(7);
+    std::vector<Task> tasks(count);
+    for (int v = 0; v < count; ++v) {
+        tasks[v].taskId = v;
+        tasks[v].computationCost = 25.0 * (1 + rng() % 4);
+        tasks[v].spm_size = 1;
+        tasks[v].num_lane = 1;
+        int parents = v == 0 ? 0 : 1 + static_cast<int>(rng() % 3);
+        for (int k = 0; k < parents; ++k) {
+            addEdge(tasks, v - 1 - static_cast<int>(rng() % std::min(v, 64)), v);
+        }
+    }
+    return tasks;
+}
+
+// 返回 3 次 run() 中的最小耗时（ms），events 为最后一次的分配结果
+double timeRun(const std::vector<Task>& tasks, const std::vector<Tile>& tiles, WorkerPool* pool,
+               std::vector<Event>& events) {
+    double best = 1e300;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        HEFTPlanningAlgorithm planner(tasks, tiles);
+        if (pool != nullptr) {
+            planner.setWorkerPool(pool);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        planner.run();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - begin).count());
+        events = planner.getTaskEvents();
+    }
+    return best;
+}
+
+bool sameEvents(const std::vector<Event>& a, const std::vector<Event>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].tileId != b[i].tileId || a[i].start != b[i].start || a[i].finish != b[i].finish) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int taskCount = argc > 1 ? std::atoi(argv[1]) : 5000;
+    std::vector<int> threadCounts;
+    for (int i = 2; i < argc; ++i) {
+        threadCounts.push_back(std::atoi(argv[i]));
+    }
+    if (threadCounts.empty()) {
+        threadCounts = {2, 4};
+    }
+
+    std::vector<Task> tasks = makeTasks(taskCount);
+    std::printf("tasks=%d\n", taskCount);
+    std::printf("%6s %8s %10s %12s %9s\n", "tiles", "threads", "serial_ms", "parallel_ms", "speedup");
+    for (int tileCount : {8, 16, 64, 256}) {
+        std::vector<Tile> tiles;
+        for (int p = 0; p < tileCount; ++p) {
+            tiles.push_back({p, 100.0 * (1 << (p % 3)), 1, 1, false, false, false});
+        }
+        std::vector<Event> serial;
+        double serialMs = timeRun(tasks, tiles, nullptr, serial);
+        for (int threads : threadCounts) {
+            WorkerPool pool(threads);
+            std::vector<Event> parallel;
+            double parallelMs = timeRun(tasks, tiles, &pool, parallel);
+            if (!sameEvents(serial, parallel)) {
+                std::fprintf(stderr, "tiles=%d threads=%d: parallel schedule differs from serial\n", tileCount,
+                             threads);
+                return 1;
+            }
+            std::printf("%6d %8d %10.2f %12.2f %8.2fx\n", tileCount, threads, serialMs, parallelMs,
+                        serialMs / parallelMs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+// JSON 输入两种解析方式的吞吐与峰值内存对比。
+//
+//     make bench/parse_bench && ./bench/parse_bench [tasks...]（默认 10000 100000 300000）
+//
+// 每个规模生成一个随机 DAG 的 JSON（与 dag_load_bench 相同的格式），分别用
+//   dom  JsonParser::parseJson（先构造 nlohmann::json 文档再取字段）
+//   sax  JsonParser::parseJsonStream（逐事件直接填充 inputTask）
+// 解析为 inputTask。每种方式在单独 fork 出的子进程中运行，峰值 RSS 取自 wait4 返回的子进程 ru_maxrss；
+// base 为不做解析的子进程的峰值 RSS。耗时取子进程内 3 次中的最小值（文件已在页缓存中）。
+// 两种方式的结果写成 .dag 后须逐字节相同（同样在子进程中比较，父进程不解析，堆保持很小）。
+#include "../include/DagFile.hpp"
+#include "../include/JsonParser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+enum class Mode { Base, Dom, Sax, Compare };
+
+void writeJson(const std::string& path, int taskCount, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << '[';
+    for (int v = 0; v < taskCount; ++v) {
+        file << (v == 0 ? "" : ",") << "{\"taskId\":\"t" << v << "\",\"computationCost\":"
+             << 1.0 + static_cast<double>(rng() % 1000) / 100.0
+             << ",\"spm_size\":1,\"num_lane\":1,\"has_bitalu\":false,\"has_serdiv\":false,\"has_complexunit\":false";
+        for (const char* field : {"text_offset", "data_offset", "total_length", "text_length", "data_length",
+                                  "output_num"}) {
+            file << ",\"" << field << "\":" << rng() % 4096;
+        }
+        file << ",\"hardwareinfo\":\"0b00000\",\"hash\":\"h" << rng() << "\",\"parentTasks\":[";
+        for (int k = 0; k < 2 && v > 0; ++k) {
+            int window = std::min(v, 64);
+            file << (k == 0 ? "" : ",") << "{\"taskId\":\"t" << v - 1 - static_cast<int>(rng() % window)
+                 << "\",\"outputIndex\":" << k << ",\"outputVar\":\"v" << k
+                 << "\",\"concat_value\":0,\"dest_address\":\"0x100000\"}";
+        }
+        file << "],\"childTasks\":[],\"global_Input\":[],\"para_Input\":[],\"return_output\":[]}\n";
+    }
+    file << "]\n";
+}
+
+std::vector<inputTask> parse(Mode mode, const std::string& path, StringPool& pool) {
+    return mode == Mode::Dom ? JsonParser::parseJson(path, pool) : JsonParser::parseJsonStream(path, pool);
+}
+
+long long fileSize(const std::string& path) {
+    struct stat info;
+    return ::stat(path.c_str(), &info) == 0 ? static_cast<long long>(info.st_size) : -1;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+struct Measurement {
+    double ms = 0.0;
+    double peakMb = 0.0;
+};
+
+// 两种解析的结果经 DagFile::write 规范化后比较
+bool sameResult(const std::string& path) {
+    std::string domPath = path + ".dom.dag";
+    std::string saxPath = path + ".sax.dag";
+    for (Mode mode : {Mode::Dom, Mode::Sax}) {
+        StringPool pool;
+        DagFile::write(mode == Mode::Dom ? domPath : saxPath, parse(mode, path, pool), pool);
+    }
+    bool same = readFile(domPath) == readFile(saxPath);
+    std::remove(domPath.c_str());
+    std::remove(saxPath.c_str());
+    return same;
+}
+
+// 在子进程中解析，耗时经管道传回
+Measurement measure(Mode mode, const std::string& path) {
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+    pid_t child = ::fork();
+    if (child < 0) {
+        std::perror("fork");
+        std::exit(1);
+    }
+    if (child == 0) {
+        ::close(fds[0]);
+        double best = 0.0;
+        if (mode == Mode::Compare && !sameResult(path)) {
+            std::fprintf(stderr, "dom and sax results differ for %s\n", path.c_str());
+            ::_exit(1);
+        }
+        if (mode == Mode::Dom || mode == Mode::Sax) {
+            best = 1e300;
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                auto begin = std::chrono::steady_clock::now();
+                StringPool pool;
+                std::vector<inputTask> tasks = parse(mode, path, pool);
+                best = std::min(best, std::chrono::duration<double, std::milli>(
+                                          std::chrono::steady_clock::now() - begin).count());
+            }
+        }
+        bool written = ::write(fds[1], &best, sizeof(best)) == static_cast<ssize_t>(sizeof(best));
+        ::_exit(written ? 0 : 1);
+    }
+    ::close(fds[1]);
+    Measurement result;
+    bool received = ::read(fds[0], &result.ms, sizeof(result.ms)) == static_cast<ssize_t>(sizeof(result.ms));
+    ::close(fds[0]);
+    int status = 0;
+    struct rusage usage;
+    if (::wait4(child, &status, 0, &usage) != child || !received || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::fprintf(stderr, "parse of %s failed\n", path.c_str());
+        std::exit(1);
+    }
+    result.peakMb = usage.ru_maxrss / 1024.0;
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {10000, 100000, 300000};
+    }
+    char directory[] = "/tmp/parse_benchXXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+
+    std::printf("%8s %8s %9s %9s %10s %10s %8s %10s %10s\n", "tasks", "json MB", "dom ms", "sax ms", "dom MB/s",
+                "sax MB/s", "base MB", "dom RSS MB", "sax RSS MB");
+    for (int taskCount : sizes) {
+        std::string jsonPath = std::string(directory) + "/dag" + std::to_string(taskCount) + ".json";
+        writeJson(jsonPath, taskCount, taskCount);
+        measure(Mode::Compare, jsonPath);
+        Measurement base = measure(Mode::Base, jsonPath);
+        Measurement dom = measure(Mode::Dom, jsonPath);
+        Measurement sax = measure(Mode::Sax, jsonPath);
+        double megabytes = fileSize(jsonPath) / 1048576.0;
+        std::printf("%8d %8.1f %9.1f %9.1f %10.1f %10.1f %8.1f %10.1f %10.1f\n", taskCount, megabytes, dom.ms, sax.ms,
+                    megabytes / (dom.ms / 1e3), megabytes / (sax.ms / 1e3), base.peakMb, dom.peakMb, sax.peakMb);
+        std::remove(jsonPath.c_str());
+    }
+    ::rmdir(directory);
+    return 0;
+}
@@ -0,0 +1,202 @@
+// rank 阶段（拓扑序 + 逆拓扑序单次扫描 + 排序）的耗时，以及与基线递归实现的对比。
+//
+//     make bench/rank_bench && ./bench/rank_bench [tiles=3] [sizes...=1000 10000 100000]
+//
+// 两种形状：local 为随机 DAG，每个任务 1–3 个父任务，取自前 8 个任务；chain 为一条链。
+// sweep 为 HEFTPlanningAlgorithm::calculateRanks 的耗时（取 3 次中的最小值）。
+// recursive 为基线的做法：逐任务递归 + std::map 记忆化，父子关系与代价都在 map 中，另有按 Kahn 层数给出的 epsilon；
+// 递归深度可达任务数，只对不超过 kRecursiveLimit 个任务的输入运行。
+#include "../include/HEFTPlanningAlgorithm.hpp"
+#include "../include/TaskConverter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+
+namespace {
+
+const int kRecursiveLimit = 20000;
+
+double elapsedMs(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+std::vector<Task> makeTasks(int count, bool chain, std::mt19937& rng) {
+    std::uniform_real_distribution<double> cost(1.0, 100.0);
+    std::vector<double> costs(count);
+    std::vector<int> ones(count, 1);
+    std::vector<int> none(count, 0);
+    std::vector<int> sources;
+    std::vector<int> targets;
+    std::vector<int> bytes;
+    for (int v = 0; v < count; ++v) {
+        costs[v] = cost(rng);
+        int parents = v == 0 ? 0 : chain ? 1 : 1 + static_cast<int>(rng() % 3);
+        for (int k = 0; k < parents; ++k) {
+            int window = chain ? 1 : std::min(v, 8);
+            sources.push_back(v - 1 - static_cast<int>(rng() % window));
+            targets.push_back(v);
+            bytes.push_back(static_cast<int>(rng() % 64));
+        }
+    }
+    return TaskConverter::buildTasks(count, costs.data(), ones.data(), ones.data(), none.data(),
+                                     static_cast<int>(sources.size()), sources.data(), targets.data(), bytes.data());
+}
+
+class TimedRanks : public HEFTPlanningAlgorithm {
+public:
+    using HEFTPlanningAlgorithm::HEFTPlanningAlgorithm;
+
+    double rankMs = 0.0;
+
+protected:
+    void calculateRanks() override {
+        auto begin = std::chrono::steady_clock::now();
+        HEFTPlanningAlgorithm::calculateRanks();
+        rankMs = elapsedMs(begin);
+    }
+};
+
+// 基线的 rank 计算，代价取自同一个 TaskGraph 与 CommModel，结构换回 map-of-maps
+class RecursiveRanks {
+public:
+    RecursiveRanks(const std::vector<Task>& tasks, const TaskGraph& dag, const CommModel& comm) : tasks(tasks) {
+        for (int t = 0; t < dag.numTasks; ++t) {
+            for (int p = 0; p < dag.numTiles; ++p) {
+                computationCosts[t][p] = dag.computationCost(t, p);
+            }
+            for (int e = dag.childOffsets[t]; e < dag.childOffsets[t + 1]; ++e) {
+                transferCosts[t][dag.childIds[e]] = comm.averageCost(dag.childBytes[e]);
+            }
+        }
+    }
+
+    void run() {
+        std::map<int, std::vector<int>> graph;
+        std::map<int, int> inDegree;
+        std::map<int, int> levels;
+        for (const auto& task : tasks) {
+            for (const auto& parent : task.parentTasks) {
+                graph[parent.taskId].push_back(task.taskId);
+                inDegree[task.taskId]++;
+                inDegree.emplace(parent.taskId, 0);
+            }
+        }
+        std::queue<int> ready;
+        for (const auto& entry : inDegree) {
+            if (entry.second == 0) {
+                ready.push(entry.first);
+                levels[entry.first] = static_cast<int>(inDegree.size());
+            }
+        }
+        while (!ready.empty()) {
+            int current = ready.front();
+            ready.pop();
+            for (int child : graph[current]) {
+                if (--inDegree[child] == 0) {
+                    ready.push(child);
+                    levels[child] = levels[current] - 1;
+                }
+            }
+        }
+        for (const auto& task : tasks) {
+            epsilon = levels[task.taskId];
+            rankOf(task);
+        }
+        ranks.assign(rank.begin(), rank.end());
+        std::sort(ranks.begin(), ranks.end(),
+                  [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.second > b.second; });
+    }
+
+private:
+    const std::vector<Task>& tasks;
+    std::map<int, std::map<int, double>> computationCosts;
+    std::map<int, std::map<int, double>> transferCosts;
+    std::map<int, double> rank;
+    std::set<int> calculating;
+    std::vector<std::pair<int, double>> ranks;
+    double epsilon = 0.0;
+
+    double rankOf(const Task& task) {
+        auto found = rank.find(task.taskId);
+        if (found != rank.end()) {
+            return found->second;
+        }
+        if (calculating.count(task.taskId) > 0) {
+            return 0.0;
+        }
+        calculating.insert(task.taskId);
+        double average = 0.0;
+        for (const auto& cost : computationCosts[task.taskId]) {
+            if (cost.second != std::numeric_limits<double>::infinity()) {
+                average += cost.second;
+            }
+        }
+        average /= computationCosts[task.taskId].size();
+        double maxChildCost = 0.0;
+        for (const auto& child : task.childTasks) {
+            if (child.taskId != -1) {
+                double childCost = transferCosts[task.taskId][child.taskId] + rankOf(tasks[child.taskId]) + epsilon;
+                maxChildCost = std::max(maxChildCost, childCost);
+            }
+        }
+        calculating.erase(task.taskId);
+        rank[task.taskId] = average + maxChildCost;
+        return rank[task.taskId];
+    }
+};
+
+}
+
+int main(int argc, char* argv[]) {
+    int tileCount = argc > 1 ? std::atoi(argv[1]) : 3;
+    std::vector<int> sizes;
+    for (int i = 2; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 100000};
+    }
+
+    std::vector<Tile> tiles;
+    for (int p = 0; p < tileCount; ++p) {
+        tiles.push_back({p, 100.0 * (1.0 + p % 4), 1, 1, false, false, false});
+    }
+    auto comm = std::make_shared<const CommModel>(tiles, MeshTopology());
+
+    std::printf("tiles=%d\n", tileCount);
+    std::printf("%-6s %8s %8s %10s %13s %9s\n", "shape", "tasks", "edges", "sweep_ms", "recursive_ms", "speedup");
+    std::mt19937 rng(7);
+    for (bool chain : {false, true}) {
+        for (int size : sizes) {
+            std::vector<Task> tasks = makeTasks(size, chain, rng);
+            double sweepMs = 1e300;
+            std::unique_ptr<TimedRanks> planner;
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                planner = std::make_unique<TimedRanks>(tasks, tiles, comm);
+                planner->run();
+                sweepMs = std::min(sweepMs, planner->rankMs);
+            }
+            const TaskGraph& dag = planner->getTaskGraph();
+            int edges = dag.parentOffsets[dag.numTasks];
+            const char* shape = chain ? "chain" : "local";
+            if (size > kRecursiveLimit) {
+                std::printf("%-6s %8d %8d %10.2f %13s %9s\n", shape, size, edges, sweepMs, "-", "-");
+                continue;
+            }
+            RecursiveRanks recursive(tasks, dag, *comm);
+            auto begin = std::chrono::steady_clock::now();
+            recursive.run();
+            double recursiveMs = elapsedMs(begin);
+            std::printf("%-6s %8d %8d %10.2f %13.2f %8.1fx\n", shape, size, edges, sweepMs, recursiveMs,
+                        recursiveMs / sweepMs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+// 增量重规划与从头规划的耗时对比。
+//
+//     make bench/replan_bench && ./bench/replan_bench [tasks=20000] [tiles=16] [trials=5]
+//
+// 随机分层 DAG 上施加不同规模的随机 delta（改代价、增删边、增删任务），变化位置取自整个 DAG（any）
+// 或只取自下标最大的 10% 任务（tail，对应在 DAG 末端增改节点）。每次同时用
+// replan 和对变化后任务集合的 run() 规划，校验两者的 rank 与分配结果逐项相同。
+#include "../include/HEFTPlanningAlgorithm.hpp"
+#include "../include/TaskConverter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+std::vector<Task> makeTasks(int count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> cost(1.0, 100.0);
+    std::vector<double> costs(count);
+    std::vector<int> ones(count, 1);
+    std::vector<int> none(count, 0);
+    std::vector<int> sources;
+    std::vector<int> targets;
+    for (int v = 0; v < count; ++v) {
+        costs[v] = cost(rng);
+        for (int k = 0; k < 2 && v > 0; ++k) {
+            int window = std::min(v, 64);
+            sources.push_back(v - 1 - static_cast<int>(rng() % window));
+            targets.push_back(v);
+        }
+    }
+    return TaskConverter::buildTasks(count, costs.data(), ones.data(), ones.data(), none.data(),
+                                     static_cast<int>(sources.size()), sources.data(), targets.data());
+}
+
+TaskDelta makeDelta(int size, int taskCount, int firstTask, std::mt19937& rng) {
+    // 按下标从小到大连边，保持无环
+    TaskDelta delta;
+    int span = taskCount - firstTask;
+    std::uniform_real_distribution<double> cost(1.0, 100.0);
+    std::vector<char> removed(taskCount, 0);
+    for (int i = 0; i < size; ++i) {
+        int kind = static_cast<int>(rng() % 10);
+        int a = firstTask + static_cast<int>(rng() % span);
+        int b = firstTask + static_cast<int>(rng() % span);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        if (kind < 5) {
+            delta.changedCosts.push_back({a, cost(rng)});
+        } else if (kind < 7 && a != b) {
+            delta.addedEdges.push_back({a, b});
+        } else if (kind < 8 && a != b) {
+            delta.removedEdges.push_back({a, b});
+        } else if (kind < 9) {
+            Task task = Task();
+            task.computationCost = cost(rng);
+            task.spm_size = 1;
+            task.num_lane = 1;
+            int id = taskCount + static_cast<int>(delta.addedTasks.size());
+            delta.addedTasks.push_back(task);
+            delta.addedEdges.push_back({a, id});
+        } else if (!removed[a]) {
+            removed[a] = 1;
+            delta.removedTasks.push_back(a);
+        }
+    }
+    return delta;
+}
+
+bool sameSchedule(const HEFTPlanningAlgorithm& a, const HEFTPlanningAlgorithm& b) {
+    const auto& ea = a.getTaskEvents();
+    const auto& eb = b.getTaskEvents();
+    if (ea.size() != eb.size() || a.getRanks() != b.getRanks()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < ea.size(); ++i) {
+        if (ea[i].taskId != eb[i].taskId || ea[i].tileId != eb[i].tileId ||
+            ea[i].start != eb[i].start || ea[i].finish != eb[i].finish) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int taskCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int tileCount = argc > 2 ? std::atoi(argv[2]) : 16;
+    int trials = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    std::mt19937 rng(1);
+    std::vector<Tile> tiles;
+    for (int p = 0; p < tileCount; ++p) {
+        tiles.push_back({p, 100.0 * (1.0 + p % 4), 1, 1, false, false, false});
+    }
+
+    std::printf("tasks=%d tiles=%d trials=%d\n", taskCount, tileCount, trials);
+    std::printf("%6s %8s %12s %12s %9s %14s\n", "region", "delta", "replan_ms", "full_ms", "speedup", "reallocated");
+    for (const char* region : {"any", "tail"}) {
+        int firstTask = region[0] == 't' ? taskCount - taskCount / 10 : 0;
+        for (int size : {1, 10, 100, 1000}) {
+            double replanMs = 0.0;
+            double fullMs = 0.0;
+            long long reallocated = 0;
+            for (int trial = 0; trial < trials; ++trial) {
+                HEFTPlanningAlgorithm planner(makeTasks(taskCount, rng), tiles);
+                planner.run();
+                TaskDelta delta = makeDelta(size, taskCount, firstTask, rng);
+
+                auto begin = std::chrono::steady_clock::now();
+                reallocated += planner.replan(delta);
+                replanMs += elapsedMs(begin);
+
+                begin = std::chrono::steady_clock::now();
+                HEFTPlanningAlgorithm full(planner.getTasks(), tiles);
+                full.run();
+                fullMs += elapsedMs(begin);
+
+                if (!sameSchedule(planner, full)) {
+                    std::fprintf(stderr, "replan differs from a full run (delta %d, trial %d)\n", size, trial);
+                    return 1;
+                }
+            }
+            std::printf("%6s %8d %12.2f %12.2f %8.1fx %13.1f%%\n", region, size, replanMs / trials, fullMs / trials,
+                        fullMs / replanMs, 100.0 * reallocated / trials / taskCount);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+"""
+调度器基准：对每种 DAG 形状与规模生成输入，运行 main 并汇总 --trace-report 的结果。
+
+    make bench [BENCH_ARGS="--sizes 100 1000 10000 100000 1000000 --tiles 16 64 256"]
+    python3 bench/run_bench.py [--exe ./main] [--shapes fft gaussian] [--sizes 100 1000]
+        [--tiles 8 64] [--tile-classes 2] [--heterogeneity 4] [--seed 1] [--planners heft peft]
+        [--threads 1 4] [--report results.jsonl]
+
+每行输出各阶段耗时（ms）、峰值 RSS、makespan 与 SLR；给出多个 TILE 数时每个 TILE 数生成一份硬件描述（main --hardware），
+给出多个规划器时同一输入依次用各规划器运行。生成的输入缓存在 --workdir 中，相同参数再次运行时直接复用。
+--threads 给出多个值时同一用例依次用各线程数运行（main --threads，并行评估各 TILE 的 EFT，TILE 数不少于 16 时启用），
+allocate 列即串行与并行的对比；各线程数的输出须与第一个线程数的逐字节相同，否则报错退出。
+"""
+import argparse
+import filecmp
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from gen_dag import SHAPES, make_tiles, write_dag  # noqa: E402
+
+PHASES = ("parse", "convert", "cost_tables", "rank", "allocate", "emit")
+
+
+def prepare_inputs(workdir, shape, nodes, tile_count, args):
+    stem = f"{shape}_{nodes}_t{tile_count}c{args.tile_classes}h{args.heterogeneity:g}s{args.seed}"
+    dag_path = os.path.join(workdir, stem + ".json")
+    tile_path = os.path.join(workdir, stem + ".tiles.json")
+    if not os.path.exists(dag_path):
+        rng = random.Random(args.seed)
+        tiles = make_tiles(tile_count, min(args.tile_classes, tile_count), args.heterogeneity, 100.0, rng)
+        with open(tile_path, "w") as f:
+            json.dump(tiles, f)
+        with open(dag_path + ".tmp", "w") as f:
+            write_dag(f, shape, nodes, tiles, rng)
+        os.replace(dag_path + ".tmp", dag_path)
+    return dag_path, tile_path
+
+
+def run_case(exe, dag_path, tile_path, workdir, planner, threads, output_path):
+    report_path = os.path.join(workdir, "report.jsonl")
+    if os.path.exists(report_path):
+        os.remove(report_path)
+    start = time.perf_counter()
+    subprocess.run([exe, dag_path, output_path, "--hardware", tile_path, "--compact", "--planner", planner,
+                    "--threads", str(threads), "--trace-report", report_path], check=True)
+    wall = time.perf_counter() - start
+    with open(report_path) as f:
+        report = json.loads(f.readline())
+    report["wall_ms"] = wall * 1e3
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--exe", default="./main")
+    parser.add_argument("--shapes", nargs="+", choices=SHAPES, default=list(SHAPES))
+    parser.add_argument("--sizes", nargs="+", type=int, default=[100, 1000, 10000, 100000])
+    parser.add_argument("--tiles", nargs="+", type=int, default=[8])
+    parser.add_argument("--tile-classes", type=int, default=2)
+    parser.add_argument("--heterogeneity", type=float, default=4.0)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--planners", nargs="+", choices=("heft", "peft"), default=["heft"])
+    parser.add_argument("--threads", nargs="+", type=int, default=[1])
+    parser.add_argument("--workdir", default=os.path.join(tempfile.gettempdir(), "heft_bench"))
+    parser.add_argument("--report", help="追加每个用例的完整结果（JSON Lines）")
+    args = parser.parse_args()
+
+    os.makedirs(args.workdir, exist_ok=True)
+    exe = os.path.abspath(args.exe)
+    header = f"{'shape':9s} {'nodes':>8s} {'tiles':>5s} {'planner':7s} {'thr':>3s} " + " ".join(f"{p:>11s}" for p in PHASES) + \
+             f" {'wall':>9s} {'rss_mb':>8s} {'makespan':>10s} {'slr':>7s}"
+    print(header)
+    for shape in args.shapes:
+        for nodes in args.sizes:
+            for tile_count in args.tiles:
+                dag_path, tile_path = prepare_inputs(args.workdir, shape, nodes, tile_count, args)
+                for planner in args.planners:
+                    for index, threads in enumerate(args.threads):
+                        output_path = os.path.join(args.workdir, f"output{min(index, 1)}.json")
+                        report = run_case(exe, dag_path, tile_path, args.workdir, planner, threads, output_path)
+                        phases = " ".join(f"{report['phases'][p]['us'] / 1e3:11.2f}" for p in PHASES)
+                        schedule = report["schedule"]
+                        print(f"{shape:9s} {nodes:8d} {tile_count:5d} {planner:7s} {threads:3d} {phases} "
+                              f"{report['wall_ms']:9.1f} {report['max_rss_kb'] / 1024:8.1f} "
+                              f"{schedule['makespan']:10.2f} {schedule['slr']:7.3f}", flush=True)
+                        if index > 0 and not filecmp.cmp(output_path, os.path.join(args.workdir, "output0.json"),
+                                                         shallow=False):
+                            sys.exit(f"output with --threads {threads} differs from --threads {args.threads[0]}")
+                        if args.report:
+                            report.update(shape=shape, nodes=nodes, planner=planner, tiles=tile_count, threads=threads,
+                                          tile_classes=args.tile_classes, heterogeneity=args.heterogeneity)
+                            with open(args.report, "a") as f:
+                                f.write(json.dumps(report) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,113 @@
+// SIMD 内核在不同 TILE 数下的耗时与加速比。
+//
+//     make bench/simd_bench && ./bench/simd_bench [rows=4096] [repeats=20]
+//
+// 对 8–512 个 TILE，分别用标量、SSE2、AVX2（CPU 支持时）实现运行各内核，并校验结果与标量实现逐位相同：
+//   divide      rows × tiles 的代价矩阵（TaskGraph::build）
+//   row_avg     代价矩阵逐行的有限项平均（rank）
+//   add_argmin  tiles 个完成时间与得分的 argmin（evaluateTiles）
+#include "../include/SimdKernels.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename Body>
+double nanosecondsPerCall(int calls, Body body) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        body(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / calls;
+}
+
+bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? std::atoi(argv[1]) : 4096;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> capacity(50.0, 400.0);
+    std::uniform_real_distribution<double> cost(1.0, 300.0);
+
+    std::vector<SimdKernels::Level> levels = {SimdKernels::Level::Scalar};
+    for (SimdKernels::Level level : {SimdKernels::Level::SSE2, SimdKernels::Level::AVX2}) {
+        if (level <= SimdKernels::supported()) {
+            levels.push_back(level);
+        }
+    }
+
+    std::printf("rows=%d supported=%s (ns per call; speedup vs scalar)\n", rows,
+                SimdKernels::name(SimdKernels::supported()));
+    std::printf("%6s %-7s %16s %16s %16s\n", "tiles", "impl", "divide", "row_avg", "add_argmin");
+    for (int tiles : {8, 16, 32, 64, 128, 256, 512}) {
+        std::vector<double> capacities(tiles);
+        for (auto& c : capacities) {
+            c = capacity(rng);
+        }
+        std::vector<double> costs(rows);
+        for (auto& c : costs) {
+            c = cost(rng);
+        }
+        std::vector<double> starts(tiles);
+        for (auto& s : starts) {
+            s = cost(rng);
+        }
+
+        std::vector<double> referenceMatrix;
+        std::vector<double> referenceAverages;
+        std::vector<double> referenceOther;
+        double scalarNs[3] = {0, 0, 0};
+        for (SimdKernels::Level level : levels) {
+            SimdKernels::setLevel(level);
+            std::vector<double> matrix(static_cast<std::size_t>(rows) * tiles);
+            std::vector<double> averages(rows);
+            std::vector<double> sums(tiles);
+            double ns[3];
+            ns[0] = nanosecondsPerCall(repeats, [&](int) {
+                for (int r = 0; r < rows; ++r) {
+                    SimdKernels::divideCosts(costs[r], capacities.data(), matrix.data() + static_cast<std::size_t>(r) * tiles, tiles);
+                }
+            }) / rows;
+            ns[1] = nanosecondsPerCall(repeats, [&](int) {
+                SimdKernels::finiteRowAverages(matrix.data(), rows, tiles, averages.data());
+            }) / rows;
+            int choice = 0;
+            ns[2] = nanosecondsPerCall(repeats * 1000, [&](int i) {
+                starts[i % tiles] += 1e-9;
+                choice += SimdKernels::addArgmin(starts.data(), matrix.data(), sums.data(), tiles);
+            });
+
+            std::vector<double> other = {static_cast<double>(choice)};
+            other.insert(other.end(), sums.begin(), sums.end());
+            if (level == SimdKernels::Level::Scalar) {
+                referenceMatrix = matrix;
+                referenceAverages = averages;
+                referenceOther = other;
+                std::memcpy(scalarNs, ns, sizeof(ns));
+            } else if (!sameBits(matrix, referenceMatrix) || !sameBits(averages, referenceAverages) ||
+                       !sameBits(other, referenceOther)) {
+                std::fprintf(stderr, "%s results differ from scalar at %d tiles\n", SimdKernels::name(level), tiles);
+                return 1;
+            }
+            // add_argmin 的输入在各实现间须相同
+            for (int i = 0; i < repeats * 1000; ++i) {
+                starts[i % tiles] -= 1e-9;
+            }
+            std::printf("%6d %-7s", tiles, SimdKernels::name(level));
+            for (int k = 0; k < 3; ++k) {
+                std::printf(" %9.1f (%4.1fx)", ns[k], scalarNs[k] / ns[k]);
+            }
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+// TileTimeline 与基线线性 findFinishTime 的一致性检查及耗时对比。
+//
+//     make bench/timeline_bench && ./bench/timeline_bench [trials=3000] [sizes...=1000 10000 100000]
+//
+// 一致性：随机的 (readyTime, 代价) 序列，取值落在小的整数网格上以制造大量相等端点与长度为 0 的 gap，
+// 偶尔出现无穷代价；逐次比较两者给出的完成时间，并随机占用其中约 2/3 的位置。每轮结束后再用
+// rebuild 由已占用区间重建时间线，校验其与逐个 occupy 的结果对后续查询相同。
+// 耗时：每个 TILE 上 n 次查询 + 占用，线性版本为 O(n) 查找 + vector 插入，时间线为 O(log n)。
+#include "../include/TileTimeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Busy {
+    double start;
+    double finish;
+};
+
+// 基线 HEFTPlanningAlgorithm::findFinishTime：从事件列表末尾向前找第一个能放下的空档
+double linearFinishTime(std::vector<Busy>& sched, double readyTime, double computationCost, bool occupySlot) {
+    double start, finish;
+    int pos;
+    if (sched.empty()) {
+        if (occupySlot) {
+            sched.push_back({readyTime, readyTime + computationCost});
+        }
+        return readyTime + computationCost;
+    }
+    if (sched.size() == 1) {
+        if (readyTime >= sched[0].finish) {
+            pos = 1;
+            start = readyTime;
+        } else if (readyTime + computationCost <= sched[0].start) {
+            pos = 0;
+            start = readyTime;
+        } else {
+            pos = 1;
+            start = sched[0].finish;
+        }
+        if (occupySlot) {
+            sched.insert(sched.begin() + pos, {start, start + computationCost});
+        }
+        return start + computationCost;
+    }
+    start = std::max(readyTime, sched[sched.size() - 1].finish);
+    finish = start + computationCost;
+    int i = sched.size() - 1;
+    int j = sched.size() - 2;
+    pos = i + 1;
+    while (j >= 0) {
+        if (readyTime > sched[j].finish) {
+            if (readyTime + computationCost <= sched[i].start) {
+                start = readyTime;
+                finish = readyTime + computationCost;
+                pos = i;
+            }
+            break;
+        }
+        if (sched[j].finish + computationCost <= sched[i].start) {
+            start = sched[j].finish;
+            finish = sched[j].finish + computationCost;
+            pos = i;
+        }
+        i--;
+        j--;
+    }
+    if (readyTime + computationCost <= sched[0].start) {
+        if (occupySlot) {
+            sched.insert(sched.begin(), {readyTime, readyTime + computationCost});
+        }
+        return readyTime + computationCost;
+    }
+    if (occupySlot) {
+        sched.insert(sched.begin() + pos, {start, finish});
+    }
+    return finish;
+}
+
+void mismatch(int trial, int op, double ready, double cost, double expected, double actual, const char* what) {
+    std::fprintf(stderr, "%s mismatch: trial %d op %d ready %g cost %g linear %g timeline %g\n", what, trial, op, ready,
+                 cost, expected, actual);
+    std::exit(1);
+}
+
+long checkAgainstLinear(int trials) {
+    std::mt19937 rng(1);
+    long checks = 0;
+    for (int trial = 0; trial < trials; ++trial) {
+        std::vector<Busy> sched;
+        TileTimeline timeline;
+        int ops = 1 + static_cast<int>(rng() % 300);
+        int grid = 1 + static_cast<int>(rng() % 4);
+        for (int k = 0; k < ops; ++k) {
+            double ready = static_cast<double>(rng() % (ops * 2 + 1)) / grid;
+            double cost = static_cast<double>(rng() % 6) / grid;
+            if (rng() % 50 == 0) {
+                cost = std::numeric_limits<double>::infinity();
+            }
+            double expected = linearFinishTime(sched, ready, cost, false);
+            double start = timeline.earliestStart(ready, cost);
+            ++checks;
+            if (expected != start + cost) {
+                mismatch(trial, k, ready, cost, expected, start + cost, "earliestStart");
+            }
+            if (rng() % 3 != 0) {
+                linearFinishTime(sched, ready, cost, true);
+                timeline.occupy(start, start + cost);
+            }
+        }
+
+        std::vector<std::pair<double, double>> busy;
+        for (const Busy& event : sched) {
+            busy.push_back({event.start, event.finish});
+        }
+        TileTimeline rebuilt;
+        rebuilt.rebuild(busy);
+        for (int k = 0; k < 50; ++k) {
+            double ready = static_cast<double>(rng() % (ops * 2 + 1)) / grid;
+            double cost = static_cast<double>(rng() % 6) / grid;
+            double expected = timeline.earliestStart(ready, cost);
+            double actual = rebuilt.earliestStart(ready, cost);
+            ++checks;
+            if (expected != actual) {
+                mismatch(trial, k, ready, cost, expected, actual, "rebuild");
+            }
+        }
+    }
+    return checks;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int trials = argc > 1 ? std::atoi(argv[1]) : 3000;
+    std::vector<int> sizes;
+    for (int i = 2; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 100000};
+    }
+
+    long checks = checkAgainstLinear(trials);
+    std::printf("trials=%d checks=%ld: timeline matches linear findFinishTime\n", trials, checks);
+
+    // 与规划时相同：每个任务先查询一次（评估），再查询并占用一次（分配）
+    std::printf("%8s %11s %13s %9s\n", "events", "linear_ms", "timeline_ms", "speedup");
+    for (int n : sizes) {
+        std::mt19937 rng(2);
+        std::vector<double> ready(n);
+        std::vector<double> cost(n);
+        for (int k = 0; k < n; ++k) {
+            ready[k] = static_cast<double>(rng() % (n * 3));
+            cost[k] = 1.0 + static_cast<double>(rng() % 3);
+        }
+
+        std::vector<Busy> sched;
+        auto begin = std::chrono::steady_clock::now();
+        for (int k = 0; k < n; ++k) {
+            linearFinishTime(sched, ready[k], cost[k], false);
+            linearFinishTime(sched, ready[k], cost[k], true);
+        }
+        double linearMs = elapsedMs(begin);
+
+        TileTimeline timeline;
+        begin = std::chrono::steady_clock::now();
+        for (int k = 0; k < n; ++k) {
+            timeline.earliestStart(ready[k], cost[k]);
+            double start = timeline.earliestStart(ready[k], cost[k]);
+            timeline.occupy(start, start + cost[k]);
+        }
+        double timelineMs = elapsedMs(begin);
+        std::printf("%8d %11.2f %13.2f %8.1fx\n", n, linearMs, timelineMs, linearMs / timelineMs);
+    }
+    return 0;
+}
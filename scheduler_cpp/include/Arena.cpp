@@ -0,0 +1,59 @@
+#include "Arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+Arena::Arena(std::size_t initialBytes) {
+    addBlock(std::max<std::size_t>(initialBytes, 1));
+}
+
+void Arena::addBlock(std::size_t minimumBytes) {
+    std::size_t size = blocks.empty() ? minimumBytes : std::max(minimumBytes, blocks.back().size * 2);
+    blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    ++allocations;
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    while (true) {
+        Block& block = blocks[current];
+        auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        std::size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+        if (aligned + bytes <= block.size) {
+            offset = aligned + bytes;
+            return block.data.get() + aligned;
+        }
+        // 已有的后续块（上一轮留下的）放不下时才申请新块
+        usedBefore += offset;
+        offset = 0;
+        if (current + 1 == blocks.size()) {
+            addBlock(bytes + alignment);
+        }
+        ++current;
+    }
+}
+
+void Arena::reset() {
+    if (current > 0) {
+        std::size_t total = capacity();
+        blocks.clear();
+        addBlock(total);
+    }
+    current = 0;
+    offset = 0;
+    usedBefore = 0;
+}
+
+std::size_t Arena::bytesUsed() const {
+    return usedBefore + offset;
+}
+
+std::size_t Arena::capacity() const {
+    std::size_t total = 0;
+    for (const auto& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+std::size_t Arena::blockAllocations() const {
+    return allocations;
+}
@@ -0,0 +1,53 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// 单调递增的内存池：分配只移动指针，释放是空操作，reset() 一次性回收全部内存。
+// 当前块不够时向上游申请新块（容量翻倍）；reset() 时若上一轮用到多个块，就把它们合并成一个
+// 足够大的块，之后同样规模的使用不再向上游申请。用作 std::pmr 容器的 memory_resource。
+// 非线程安全。
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(std::size_t initialBytes = kDefaultBlockSize);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // 此前从本池分配的内存全部失效
+    void reset();
+
+    // 本轮已分配的字节数（含对齐填充）
+    std::size_t bytesUsed() const;
+
+    // 持有的总容量
+    std::size_t capacity() const;
+
+    // 向上游申请块的次数（累计）
+    std::size_t blockAllocations() const;
+
+private:
+    static const std::size_t kDefaultBlockSize = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current = 0;        // 正在使用的块
+    std::size_t offset = 0;         // 当前块内已用字节
+    std::size_t usedBefore = 0;     // 之前各块已用字节之和
+    std::size_t allocations = 0;
+
+    void addBlock(std::size_t minimumBytes);
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+#endif // ARENA_H
@@ -0,0 +1,299 @@
+#include "BatchScheduler.hpp"
+#include "DagFile.hpp"
+#include "JsonParser.hpp"
+#include "JsonStream.hpp"
+#include "PlanningAlgorithm.hpp"
+#include "ScheduleEmitter.hpp"
+#include "TaskConverter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const kFolderInputs[] = {"slice_updated_tasks.json", "slice_updated_tasks.dag"};
+
+// 每个工作线程一个双端队列：自己从队首取，偷取时从别人的队尾取
+class StealingQueues {
+public:
+    explicit StealingQueues(int workers) : queues(workers) {}
+
+    void push(int worker, int job) {
+        queues[worker].jobs.push_back(job);
+    }
+
+    bool pop(int worker, int& job) {
+        {
+            Queue& own = queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = own.jobs.front();
+                own.jobs.pop_front();
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < queues.size(); ++k) {
+            Queue& victim = queues[(worker + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = victim.jobs.back();
+                victim.jobs.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<int> jobs;
+    };
+
+    std::vector<Queue> queues;
+};
+
+struct JobResult {
+    std::string error;
+    int tasks = 0;
+    double makespan = 0.0;
+    double slr = 0.0;
+    bool cacheHit = false;
+    double loadMs = 0.0;
+    double planMs = 0.0;
+    double emitMs = 0.0;
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point& mark) {
+    auto now = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - mark).count();
+    mark = now;
+    return ms;
+}
+
+std::string diagnosticsPath(const std::string& output) {
+    const std::string suffix = ".json";
+    if (output.size() > suffix.size() && output.compare(output.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return output.substr(0, output.size() - suffix.size()) + ".diag.json";
+    }
+    return output + ".diag.json";
+}
+
+BatchJob makeJob(const fs::path& input, const fs::path& output) {
+    return {input.string(), output.string(), diagnosticsPath(output.string())};
+}
+
+bool isInputFile(const fs::path& path) {
+    return path.extension() == ".json" || path.extension() == ".dag";
+}
+
+// 与单文件模式相同的流程：加载、转换、规划（可命中缓存）、输出
+void scheduleJob(const BatchJob& job, PlanningAlgorithm& planner, const HardwareDescription& hardware,
+                 const std::string& plannerName, bool compact, ScheduleCache* cache, JobResult& result) {
+    auto mark = std::chrono::steady_clock::now();
+    std::unique_ptr<DagFile> dagFile;
+    StringPool pool;
+    std::vector<inputTask> inputTasks;
+    std::pair<std::vector<Task>, std::unordered_map<Symbol, int>> converted;
+    if (DagFile::isDagFile(job.input)) {
+        dagFile.reset(new DagFile(job.input));
+        result.tasks = dagFile->taskCount();
+    } else {
+        inputTasks = JsonParser::parseJsonStream(job.input, pool);
+        converted = TaskConverter::convertToTasks(inputTasks);
+        result.tasks = static_cast<int>(inputTasks.size());
+    }
+    result.loadMs = elapsedMs(mark);
+
+    auto plan = [&]() {
+        if (dagFile) {
+            planner.run(*dagFile);
+        } else {
+            planner.reset(converted.first);
+            planner.run();
+        }
+        result.slr = planner.getScheduleLengthRatio();
+        return CachedSchedule{planner.getRanks(), planner.getTaskEvents()};
+    };
+    std::shared_ptr<const CachedSchedule> planned;
+    if (cache != nullptr) {
+        std::string key = dagFile ? ScheduleCache::digest(*dagFile, hardware, plannerName)
+                                  : ScheduleCache::digest(converted.first, hardware, plannerName);
+        planned = cache->getOrPlan(key, result.tasks, plan, &result.cacheHit);
+    } else {
+        planned = std::make_shared<const CachedSchedule>(plan());
+    }
+    for (const auto& event : planned->taskEvents) {
+        result.makespan = std::max(result.makespan, event.finish);
+    }
+    result.planMs = elapsedMs(mark);
+
+    std::error_code ignored;
+    fs::create_directories(fs::path(job.output).parent_path(), ignored);
+    std::ofstream file(job.output, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("cannot write " + job.output);
+    }
+    std::string buffer;
+    JsonStream out(buffer, &file, !compact);
+    if (dagFile) {
+        ScheduleEmitter::writeOutput(out, *dagFile, planned->ranks, planned->taskEvents);
+    } else {
+        ScheduleEmitter::writeOutput(out, inputTasks, pool, converted.second, planned->ranks, planned->taskEvents);
+    }
+    if (!file.flush()) {
+        throw std::runtime_error("cannot write " + job.output);
+    }
+    result.emitMs = elapsedMs(mark);
+}
+
+void writeDiagnostics(const BatchJob& job, const std::string& plannerName, const JobResult& result) {
+    std::string line;
+    JsonStream out(line, nullptr, false);
+    out.beginObject();
+    out.key("input"); out.value(job.input);
+    out.key("output"); out.value(job.output);
+    out.key("planner"); out.value(plannerName);
+    out.key("status"); out.value(result.error.empty() ? "ok" : "error");
+    if (!result.error.empty()) {
+        out.key("error"); out.value(result.error);
+    }
+    out.key("tasks"); out.value(static_cast<long long>(result.tasks));
+    if (result.error.empty()) {
+        out.key("makespan"); out.value(result.makespan);
+        if (!result.cacheHit) {
+            out.key("slr"); out.value(result.slr);
+        }
+        out.key("cache_hit"); out.value(result.cacheHit);
+    }
+    out.key("load_ms"); out.value(result.loadMs);
+    out.key("plan_ms"); out.value(result.planMs);
+    out.key("emit_ms"); out.value(result.emitMs);
+    out.endObject();
+    line += '\n';
+    std::ofstream file(job.diagnostics, std::ios::out | std::ios::trunc);
+    file << line;
+}
+
+}
+
+std::vector<BatchJob> BatchScheduler::collectJobs(const std::string& source, const std::string& outputDir) {
+    std::vector<BatchJob> jobs;
+    const fs::path outputRoot(outputDir);
+    if (fs::is_directory(source)) {
+        for (const auto& entry : fs::directory_iterator(source)) {
+            if (entry.is_directory()) {
+                for (const char* name : kFolderInputs) {
+                    fs::path input = entry.path() / name;
+                    if (fs::is_regular_file(input)) {
+                        jobs.push_back(makeJob(input, outputRoot / (entry.path().filename().string() + ".json")));
+                        break;
+                    }
+                }
+            } else if (entry.is_regular_file() && isInputFile(entry.path())) {
+                jobs.push_back(makeJob(entry.path(), outputRoot / (entry.path().stem().string() + ".json")));
+            }
+        }
+    } else {
+        std::ifstream manifest(source);
+        if (!manifest.is_open()) {
+            throw std::runtime_error("cannot open batch manifest " + source);
+        }
+        const fs::path base = fs::path(source).parent_path();
+        std::string line;
+        while (std::getline(manifest, line)) {
+            std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+            std::size_t end = line.find_first_of(" \t\r", first);
+            fs::path input = line.substr(first, end == std::string::npos ? std::string::npos : end - first);
+            std::size_t second = end == std::string::npos ? end : line.find_first_not_of(" \t\r", end);
+            fs::path output;
+            if (second != std::string::npos) {
+                std::size_t secondEnd = line.find_first_of(" \t\r", second);
+                output = line.substr(second, secondEnd == std::string::npos ? std::string::npos : secondEnd - second);
+            } else {
+                // slice_updated_tasks.json 以所在目录命名，其余以文件名命名
+                bool folderInput = std::find(std::begin(kFolderInputs), std::end(kFolderInputs),
+                                             input.filename().string()) != std::end(kFolderInputs);
+                std::string stem = folderInput && input.has_parent_path() ? input.parent_path().filename().string()
+                                                                          : input.stem().string();
+                output = outputRoot / (stem + ".json");
+            }
+            jobs.push_back(makeJob(input.is_relative() ? base / input : input,
+                                   output.is_relative() && second != std::string::npos ? base / output : output));
+        }
+    }
+    if (jobs.empty()) {
+        throw std::runtime_error("no inputs found in " + source);
+    }
+    std::sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) { return a.input < b.input; });
+    return jobs;
+}
+
+BatchSummary BatchScheduler::run(const std::vector<BatchJob>& jobs,
+                                 const std::shared_ptr<const HardwareDescription>& hardware, const std::string& planner,
+                                 int threads, bool compact, ScheduleCache* cache) {
+    auto begin = std::chrono::steady_clock::now();
+    const int workers = std::max(1, std::min(threads, static_cast<int>(jobs.size())));
+
+    // 大的输入先开始，小的留在队尾供空闲线程偷取
+    std::vector<std::pair<std::uintmax_t, int>> bySize;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        std::error_code error;
+        std::uintmax_t size = fs::file_size(jobs[i].input, error);
+        bySize.push_back({error ? 0 : size, static_cast<int>(i)});
+    }
+    std::stable_sort(bySize.begin(), bySize.end(),
+                     [](const std::pair<std::uintmax_t, int>& a, const std::pair<std::uintmax_t, int>& b) {
+                         return a.first > b.first;
+                     });
+    StealingQueues queues(workers);
+    for (std::size_t k = 0; k < bySize.size(); ++k) {
+        queues.push(static_cast<int>(k % workers), bySize[k].second);
+    }
+
+    std::atomic<int> failed(0);
+    auto work = [&](int worker) {
+        std::unique_ptr<PlanningAlgorithm> algorithm =
+            PlanningAlgorithm::create(planner, std::vector<Task>(), hardware);
+        int index;
+        while (queues.pop(worker, index)) {
+            const BatchJob& job = jobs[index];
+            JobResult result;
+            try {
+                scheduleJob(job, *algorithm, *hardware, planner, compact, cache, result);
+            } catch (const std::exception& e) {
+                result.error = e.what();
+                std::error_code ignored;
+                fs::remove(job.output, ignored);
+                ++failed;
+            }
+            writeDiagnostics(job, planner, result);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int worker = 1; worker < workers; ++worker) {
+        pool.emplace_back(work, worker);
+    }
+    work(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    BatchSummary summary;
+    summary.total = static_cast<int>(jobs.size());
+    summary.failed = failed.load();
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return summary;
+}
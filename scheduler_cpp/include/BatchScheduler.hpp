@@ -0,0 +1,41 @@
+#ifndef BATCHSCHEDULER_H
+#define BATCHSCHEDULER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "HardwareDescription.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+#include "ScheduleCache.hpp"
+
+// 一次进程内调度多个 DAG（main --batch）。
+// 输入为清单文件或目录；每个输入（JSON 或 .dag）写出与单文件模式逐字节一致的结果 JSON，
+// 以及同名的 .diag.json（单行：状态、错误信息、任务数、makespan、SLR、各阶段耗时）。
+// 作业按输入文件大小降序轮流分给各工作线程的双端队列，线程从自己的队首取、空了再从其他线程的队尾偷。
+// 每个工作线程持有一个规划器实例并在作业之间复用（reset / run），硬件描述只读共享。
+// 单个输入失败只影响它自己的输出与诊断。
+struct BatchJob {
+    std::string input;
+    std::string output;
+    std::string diagnostics;
+};
+
+struct BatchSummary {
+    int total = 0;
+    int failed = 0;
+    double seconds = 0.0;
+};
+
+class BatchScheduler {
+public:
+    // source 为目录时：子目录中的 slice_updated_tasks.json（或 .dag）输出为 <子目录名>.json，
+    // 目录下直接存放的 .json / .dag 输出为 <文件名>.json。
+    // source 为清单文件时：每行一个输入，可跟一个输出路径（空白分隔），缺省同上；空行与 # 开头的行忽略，
+    // 相对路径相对于清单所在目录。结果按输入路径排序；找不到输入时抛出 std::runtime_error
+    static std::vector<BatchJob> collectJobs(const std::string& source, const std::string& outputDir);
+
+    static BatchSummary run(const std::vector<BatchJob>& jobs, const std::shared_ptr<const HardwareDescription>& hardware,
+                            const std::string& planner, int threads, bool compact, ScheduleCache* cache = nullptr);
+};
+
+#endif // BATCHSCHEDULER_H
@@ -0,0 +1,23 @@
+#ifndef CAPABILITY_H
+#define CAPABILITY_H
+
+#include <cstdint>
+
+// 任务/TILE 的能力键。按 hardwareinfo 末 5 位的顺序（spm_size lane_num has_serdiv has_complexunit has_bitalu）
+// 从低到高打包：bit0 has_bitalu，bit1 has_complexunit，bit2 has_serdiv，bit3-31 num_lane，bit32-63 spm_size。
+// 两个键相等当且仅当五个字段都相等（字段需在 capabilityInRange 范围内）。
+const int kCapabilityLaneBits = 29;
+
+inline bool capabilityInRange(int spm_size, int num_lane) {
+    return spm_size >= 0 && num_lane >= 0 && num_lane < (1 << kCapabilityLaneBits);
+}
+
+inline uint64_t packCapability(int spm_size, int num_lane, bool has_serdiv, bool has_complexunit, bool has_bitalu) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(spm_size)) << 32) |
+           (static_cast<uint64_t>(num_lane) << 3) |
+           (static_cast<uint64_t>(has_serdiv) << 2) |
+           (static_cast<uint64_t>(has_complexunit) << 1) |
+           static_cast<uint64_t>(has_bitalu);
+}
+
+#endif // CAPABILITY_H
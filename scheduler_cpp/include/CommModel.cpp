@@ -0,0 +1,48 @@
+#include "CommModel.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+CommModel::CommModel(const std::vector<Tile>& tileList, const MeshTopology& topology)
+    : tiles(static_cast<int>(tileList.size())), mesh(topology) {
+    if (mesh.columns < 0) {
+        throw std::invalid_argument("mesh columns must not be negative");
+    }
+    if (!(mesh.linkBandwidth > 0.0)) {
+        throw std::invalid_argument("mesh linkBandwidth must be positive");
+    }
+    if (!(mesh.hopLatency >= 0.0) || !(mesh.transferOverhead >= 0.0)) {
+        throw std::invalid_argument("mesh hopLatency/transferOverhead must not be negative");
+    }
+    if (mesh.columns == 0) {
+        mesh.columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(tiles)))));
+    }
+
+    const std::size_t cells = static_cast<std::size_t>(tiles) * tiles;
+    latency.assign(cells, 0.0);
+    perByte.assign(cells, 0.0);
+    double latencySum = 0.0;
+    double perByteSum = 0.0;
+    for (int src = 0; src < tiles; ++src) {
+        for (int dst = 0; dst < tiles; ++dst) {
+            if (src == dst) {
+                continue;
+            }
+            std::size_t k = static_cast<std::size_t>(src) * tiles + dst;
+            latency[k] = mesh.transferOverhead + hops(src, dst) * mesh.hopLatency;
+            perByte[k] = 1.0 / mesh.linkBandwidth;
+            latencySum += latency[k];
+            perByteSum += perByte[k];
+        }
+    }
+    if (cells > 0) {
+        averageLatency = latencySum / cells;
+        averagePerByte = perByteSum / cells;
+    }
+}
+
+int CommModel::hops(int src, int dst) const {
+    return std::abs(src % mesh.columns - dst % mesh.columns) + std::abs(src / mesh.columns - dst / mesh.columns);
+}
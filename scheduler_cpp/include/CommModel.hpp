@@ -0,0 +1,81 @@
+#ifndef COMMMODEL_H
+#define COMMMODEL_H
+
+#include <cstddef>
+#include <vector>
+
+struct Tile;
+
+// 片上网络（2D mesh）描述。TILE 按在 TILE 集合中的下标行主序排列在 columns 列的网格上，
+// 所有链路的带宽与每跳延迟相同。
+struct MeshTopology {
+    int columns = 0;                // 0 表示取 ceil(sqrt(TILE 数))
+    double linkBandwidth = 16.0;    // 每周期字节数
+    double hopLatency = 1.0;        // 每跳周期数
+    double transferOverhead = 0.0;  // 每次跨 TILE 传输的固定周期数（注入与接收）
+    bool contention = false;        // 为 true 时按链路预约计算传输完成时间（见 LinkSchedule）
+};
+
+// 通信代价模型：cost(src, dst, bytes) = latency[src][dst] + bytes * perByte[src][dst]。
+// 跨 TILE 时 latency 为 transferOverhead + 跳数 * hopLatency，perByte 为 1 / linkBandwidth（流水传输，
+// 串行化只计一次）；同一 TILE 上两项均为 0。两个 T × T 矩阵在构造时求出，之后只读，可在线程间共享；
+// 规划内层循环按源 TILE 取一行后沿目的 TILE 连续访问，没有分支。
+class CommModel {
+public:
+    // 参数非法（columns 为负、带宽不为正、延迟为负）时抛出 std::invalid_argument
+    CommModel(const std::vector<Tile>& tiles, const MeshTopology& topology);
+
+    int tileCount() const { return tiles; }
+
+    // columns 已按 TILE 数确定
+    const MeshTopology& topology() const { return mesh; }
+
+    int rows() const { return mesh.columns > 0 ? (tiles + mesh.columns - 1) / mesh.columns : 0; }
+
+    // XY 路由的跳数（曼哈顿距离）
+    int hops(int src, int dst) const;
+
+    // 有向链路数：rows × columns 个路由器各 4 个输出方向（末行不满时多出的路由器只作转发）
+    int linkCount() const { return rows() * mesh.columns * 4; }
+
+    // 按 XY 路由（先沿行、再沿列）依次对经过的链路调用 f(link, hop)，hop 从 0 开始
+    template <typename F>
+    void forEachLink(int src, int dst, F f) const {
+        const int columns = mesh.columns;
+        int x = src % columns;
+        int y = src / columns;
+        const int toX = dst % columns;
+        const int toY = dst / columns;
+        int hop = 0;
+        while (x != toX) {
+            f((y * columns + x) * 4 + (x < toX ? 0 : 1), hop++);
+            x += x < toX ? 1 : -1;
+        }
+        while (y != toY) {
+            f((y * columns + x) * 4 + (y < toY ? 2 : 3), hop++);
+            y += y < toY ? 1 : -1;
+        }
+    }
+
+    double cost(int src, int dst, double bytes) const {
+        std::size_t k = static_cast<std::size_t>(src) * tiles + dst;
+        return latency[k] + bytes * perByte[k];
+    }
+
+    const double* latencyRow(int src) const { return latency.data() + static_cast<std::size_t>(src) * tiles; }
+
+    const double* perByteRow(int src) const { return perByte.data() + static_cast<std::size_t>(src) * tiles; }
+
+    // 源、目的在全部 TILE 上独立均匀分布（含同一 TILE）时的期望代价，用于 rank
+    double averageCost(double bytes) const { return averageLatency + bytes * averagePerByte; }
+
+private:
+    int tiles = 0;
+    MeshTopology mesh;
+    std::vector<double> latency;    // tiles × tiles，行为源 TILE
+    std::vector<double> perByte;
+    double averageLatency = 0.0;
+    double averagePerByte = 0.0;
+};
+
+#endif // COMMMODEL_H
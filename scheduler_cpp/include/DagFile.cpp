@@ -0,0 +1,327 @@
+#include "DagFile.hpp"
+#include "Trace.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+const char kDagMagic[8] = {'H', 'E', 'F', 'T', 'D', 'A', 'G', '\0'};
+const std::uint32_t kByteOrderMark = 0x01020304u;
+const std::uint32_t kKnownRequiredFeatures = kDagUnaddressedParents;
+
+static_assert(sizeof(DagFileHeader) == 40 + 16 * kDagSectionCount, "DagFileHeader layout");
+static_assert(sizeof(DagTaskRecord) == 56, "DagTaskRecord layout");
+static_assert(sizeof(DagParentRecord) == 40, "DagParentRecord layout");
+
+// 写文件时收集被引用的字符串，按首次引用的顺序编号
+class StringTable {
+public:
+    explicit StringTable(const StringPool& pool) : pool(pool), ids(pool.size(), 0) {
+        offsets.push_back(0);
+        offsets.push_back(0);
+    }
+
+    std::uint32_t operator()(Symbol symbol) {
+        if (symbol == 0) {
+            return 0;
+        }
+        if (ids[symbol] == 0) {
+            std::string_view text = pool.view(symbol);
+            bytes.insert(bytes.end(), text.begin(), text.end());
+            if (bytes.size() > UINT32_MAX) {
+                throw std::runtime_error("string table exceeds 4 GB");
+            }
+            ids[symbol] = static_cast<std::uint32_t>(offsets.size() - 1);
+            offsets.push_back(static_cast<std::uint32_t>(bytes.size()));
+        }
+        return ids[symbol];
+    }
+
+    std::vector<std::uint32_t> offsets;
+    std::vector<char> bytes;
+
+private:
+    const StringPool& pool;
+    std::vector<std::uint32_t> ids;
+};
+
+class SectionWriter {
+public:
+    SectionWriter(std::ofstream& out, DagFileHeader& header) : out(out), header(header), position(sizeof(header)) {}
+
+    template <typename T>
+    void write(DagSectionId id, const std::vector<T>& items) {
+        static const char padding[8] = {};
+        std::uint64_t aligned = (position + 7) & ~std::uint64_t(7);
+        out.write(padding, aligned - position);
+        header.sections[id] = {aligned, items.size()};
+        out.write(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(T));
+        position = aligned + items.size() * sizeof(T);
+    }
+
+    std::uint64_t size() const { return position; }
+
+private:
+    std::ofstream& out;
+    DagFileHeader& header;
+    std::uint64_t position;
+};
+
+std::uint32_t checkedCount(std::size_t count, const char* what) {
+    if (count > UINT32_MAX) {
+        throw std::runtime_error(std::string("too many ") + what + " for the .dag format");
+    }
+    return static_cast<std::uint32_t>(count);
+}
+
+}
+
+DagFile::DagFile(const std::string& path) {
+    PhaseTimer timer(TracePhase::Parse);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(DagFileHeader))) {
+        ::close(fd);
+        throw std::runtime_error(path + " is too small to be a .dag file");
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("cannot map " + path + ": " + std::strerror(errno));
+    }
+    data = static_cast<const char*>(mapping);
+    try {
+        validate(path);
+    } catch (...) {
+        ::munmap(const_cast<char*>(data), size);
+        throw;
+    }
+}
+
+DagFile::~DagFile() {
+    ::munmap(const_cast<char*>(data), size);
+}
+
+bool DagFile::isDagFile(const std::string& path) {
+    char magic[sizeof(kDagMagic)];
+    std::ifstream in(path, std::ios::binary);
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, kDagMagic, sizeof(magic)) == 0;
+}
+
+void DagFile::validate(const std::string& path) {
+    auto fail = [&path](const std::string& message) {
+        throw std::runtime_error(path + ": " + message);
+    };
+    header = reinterpret_cast<const DagFileHeader*>(data);
+    if (std::memcmp(header->magic, kDagMagic, sizeof(kDagMagic)) != 0) {
+        fail("not a .dag file");
+    }
+    if (header->byteOrder != kByteOrderMark) {
+        fail("written with a different byte order");
+    }
+    if (header->version != kVersion) {
+        fail("unsupported .dag version " + std::to_string(header->version));
+    }
+    if ((header->requiredFeatures & ~kKnownRequiredFeatures) != 0) {
+        fail("requires unsupported features");
+    }
+    if (header->fileSize != size) {
+        fail("truncated (header says " + std::to_string(header->fileSize) + " bytes)");
+    }
+
+    const std::uint64_t n = header->taskCount;
+    const std::uint64_t strings = header->stringCount;
+    auto section = [&](DagSectionId id, std::size_t elementSize, std::uint64_t expectedCount) {
+        const DagFileSection& s = header->sections[id];
+        if (expectedCount != UINT64_MAX && s.count != expectedCount) {
+            fail("section " + std::to_string(id) + " has " + std::to_string(s.count) + " elements");
+        }
+        if (s.offset % 8 != 0 || s.offset > size || s.count > (size - s.offset) / elementSize) {
+            fail("section " + std::to_string(id) + " lies outside the file");
+        }
+        return data + s.offset;
+    };
+    auto csr = [&](DagSectionId offsetsId, DagSectionId itemsId, std::size_t itemSize, std::uint64_t rows) {
+        auto offsets = reinterpret_cast<const std::uint32_t*>(section(offsetsId, sizeof(std::uint32_t), rows + 1));
+        section(itemsId, itemSize, UINT64_MAX);
+        if (offsets[0] != 0 || offsets[rows] != header->sections[itemsId].count) {
+            fail("section " + std::to_string(offsetsId) + " does not cover its records");
+        }
+        for (std::uint64_t i = 0; i < rows; ++i) {
+            if (offsets[i] > offsets[i + 1]) {
+                fail("section " + std::to_string(offsetsId) + " is not monotonic");
+            }
+        }
+        return offsets;
+    };
+
+    if (strings == 0) {
+        fail("empty string table");
+    }
+    tasks = reinterpret_cast<const DagTaskRecord*>(section(kDagTasks, sizeof(DagTaskRecord), n));
+    parentOffsets = csr(kDagParentOffsets, kDagParents, sizeof(DagParentRecord), n);
+    parents = reinterpret_cast<const DagParentRecord*>(data + header->sections[kDagParents].offset);
+    globalOffsets = csr(kDagGlobalOffsets, kDagGlobals, sizeof(DagGlobalRecord), n);
+    globals = reinterpret_cast<const DagGlobalRecord*>(data + header->sections[kDagGlobals].offset);
+    paraOffsets = csr(kDagParaOffsets, kDagParas, sizeof(DagParaRecord), n);
+    paras = reinterpret_cast<const DagParaRecord*>(data + header->sections[kDagParas].offset);
+    returnOffsets = csr(kDagReturnOffsets, kDagReturns, sizeof(DagReturnRecord), n);
+    returns = reinterpret_cast<const DagReturnRecord*>(data + header->sections[kDagReturns].offset);
+    stringOffsets = csr(kDagStringOffsets, kDagStringBytes, 1, strings);
+    stringBytes = data + header->sections[kDagStringBytes].offset;
+
+    // 记录中的下标全部在此检查一次
+    auto checkString = [&](std::uint32_t id) {
+        if (id >= strings) {
+            fail("string index " + std::to_string(id) + " out of range");
+        }
+    };
+    for (std::uint64_t t = 0; t < n; ++t) {
+        checkString(tasks[t].name);
+        checkString(tasks[t].hardwareinfo);
+        checkString(tasks[t].hash);
+    }
+    for (std::uint64_t e = 0; e < header->sections[kDagParents].count; ++e) {
+        const DagParentRecord& parent = parents[e];
+        if (parent.task < kDagUnknownTask || parent.task >= static_cast<std::int64_t>(n)) {
+            fail("parent task " + std::to_string(parent.task) + " out of range");
+        }
+        checkString(parent.varName);
+        checkString(parent.destAddressText);
+        checkString(parent.sliceLengthText);
+        checkString(parent.sliceDataTypeText);
+    }
+    for (std::uint64_t k = 0; k < header->sections[kDagGlobals].count; ++k) {
+        checkString(globals[k].name);
+        checkString(globals[k].destAddress);
+    }
+    for (std::uint64_t k = 0; k < header->sections[kDagParas].count; ++k) {
+        checkString(paras[k].name);
+        checkString(paras[k].destAddressText);
+        checkString(paras[k].sliceLengthText);
+        checkString(paras[k].sliceDataTypeText);
+    }
+    for (std::uint64_t k = 0; k < header->sections[kDagReturns].count; ++k) {
+        checkString(returns[k].name);
+    }
+}
+
+void DagFile::write(const std::string& path, const std::vector<inputTask>& inputTasks, const StringPool& pool) {
+    std::unordered_map<Symbol, int> idMapping;
+    idMapping.reserve(inputTasks.size());
+    for (std::size_t t = 0; t < inputTasks.size(); ++t) {
+        idMapping[inputTasks[t].taskId] = static_cast<int>(t);
+    }
+    Symbol noTask = 0;
+    bool hasNoTask = pool.find("-1", noTask);
+    StringTable strings(pool);
+
+    std::vector<DagTaskRecord> taskRecords;
+    std::vector<std::uint32_t> parentOffsets{0}, globalOffsets{0}, paraOffsets{0}, returnOffsets{0};
+    std::vector<DagParentRecord> parentRecords;
+    std::vector<DagGlobalRecord> globalRecords;
+    std::vector<DagParaRecord> paraRecords;
+    std::vector<DagReturnRecord> returnRecords;
+    std::uint32_t requiredFeatures = 0;
+    taskRecords.reserve(inputTasks.size());
+    for (const auto& task : inputTasks) {
+        DagTaskRecord record;
+        record.computationCost = task.computationCost;
+        record.name = strings(task.taskId);
+        record.hardwareinfo = strings(task.hardwareinfo);
+        record.hash = strings(task.hash);
+        record.capability = (task.has_bitalu ? kDagBitalu : 0) | (task.has_serdiv ? kDagSerdiv : 0) |
+                            (task.has_complexunit ? kDagComplexunit : 0);
+        record.spm_size = task.spm_size;
+        record.num_lane = task.num_lane;
+        record.text_offset = task.text_offset;
+        record.data_offset = task.data_offset;
+        record.total_length = task.total_length;
+        record.text_length = task.text_length;
+        record.data_length = task.data_length;
+        record.output_num = task.output_num;
+        taskRecords.push_back(record);
+
+        // 父任务的解析与 ScheduleEmitter 一致："-1" 优先，其次按任务名查找
+        for (const auto& parent : task.parentTasks) {
+            DagParentRecord edge;
+            auto found = idMapping.find(parent.taskId);
+            edge.task = hasNoTask && parent.taskId == noTask ? kDagNoTask
+                        : found != idMapping.end()           ? found->second
+                                                             : kDagUnknownTask;
+            edge.port = parent.port;
+            edge.concatValue = parent.concatValue;
+            edge.varName = strings(parent.varName);
+            edge.destAddressText = parent.data.hasAddress ? strings(parent.data.destAddressText) : 0;
+            if (!parent.data.hasAddress) {
+                requiredFeatures |= kDagUnaddressedParents;
+            }
+            edge.sliceLengthText = strings(parent.data.sliceLengthText);
+            edge.sliceDataTypeText = strings(parent.data.sliceDataTypeText);
+            edge.sliceDataDest = parent.data.sliceDataDest;
+            edge.bytes = static_cast<std::uint64_t>(parent.data.sliceLength) * parent.data.sliceDataType;
+            parentRecords.push_back(edge);
+        }
+        for (const auto& global : task.global_Input) {
+            globalRecords.push_back({strings(global.name), strings(global.destAddress)});
+        }
+        for (const auto& para : task.para_Input) {
+            paraRecords.push_back({strings(para.name), strings(para.data.destAddressText),
+                                   strings(para.data.sliceLengthText), strings(para.data.sliceDataTypeText),
+                                   para.data.sliceDataDest});
+        }
+        for (const auto& output : task.return_output) {
+            returnRecords.push_back({strings(output.name), output.port});
+        }
+        parentOffsets.push_back(checkedCount(parentRecords.size(), "parent edges"));
+        globalOffsets.push_back(checkedCount(globalRecords.size(), "global inputs"));
+        paraOffsets.push_back(checkedCount(paraRecords.size(), "para inputs"));
+        returnOffsets.push_back(checkedCount(returnRecords.size(), "return outputs"));
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("cannot write " + path);
+    }
+    DagFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kDagMagic, sizeof(kDagMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrderMark;
+    header.requiredFeatures = requiredFeatures;
+    header.taskCount = checkedCount(inputTasks.size(), "tasks");
+    header.stringCount = checkedCount(strings.offsets.size() - 1, "strings");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    SectionWriter sections(out, header);
+    sections.write(kDagTasks, taskRecords);
+    sections.write(kDagParentOffsets, parentOffsets);
+    sections.write(kDagParents, parentRecords);
+    sections.write(kDagGlobalOffsets, globalOffsets);
+    sections.write(kDagGlobals, globalRecords);
+    sections.write(kDagParaOffsets, paraOffsets);
+    sections.write(kDagParas, paraRecords);
+    sections.write(kDagReturnOffsets, returnOffsets);
+    sections.write(kDagReturns, returnRecords);
+    sections.write(kDagStringOffsets, strings.offsets);
+    sections.write(kDagStringBytes, strings.bytes);
+
+    // 各段位置确定后回写头部
+    header.fileSize = sections.size();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out.flush()) {
+        throw std::runtime_error("cannot write " + path);
+    }
+}
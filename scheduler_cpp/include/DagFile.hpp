@@ -0,0 +1,179 @@
+#ifndef DAGFILE_H
+#define DAGFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "HEFTPlanningAlgorithm.hpp"
+
+// 二进制 DAG 文件（.dag）。与 slice_updated_tasks.json 含同样的规划与输出所需信息，
+// 文件映射后直接按下标访问，不解析、不构造 inputTask / Task。
+//
+// 布局（本机字节序，各段 8 字节对齐）：
+//   DagFileHeader
+//   tasks          DagTaskRecord[taskCount]
+//   parentOffsets  uint32[taskCount + 1]，parents 为按任务分组的 CSR；globals / paras / returns 同理
+//   parents        DagParentRecord[]
+//   ...
+//   stringOffsets  uint32[stringCount + 1]，字符串 k 为 stringBytes[offsets[k], offsets[k + 1])
+//   stringBytes    char[]
+// 记录中的字符串字段为字符串表下标，0 固定为空串。子任务边不存储，由父边转置得到。
+// 无地址（dest_address 为 "null"）的父任务边只用于调度，记录的 destAddressText 为 0；
+// 含这种记录的文件在 requiredFeatures 中置 kDagUnaddressedParents，不认识它的读者会拒绝而不是把它输出。
+struct DagFileSection {
+    std::uint64_t offset;
+    std::uint64_t count;    // 元素个数
+};
+
+enum DagSectionId {
+    kDagTasks,
+    kDagParentOffsets,
+    kDagParents,
+    kDagGlobalOffsets,
+    kDagGlobals,
+    kDagParaOffsets,
+    kDagParas,
+    kDagReturnOffsets,
+    kDagReturns,
+    kDagStringOffsets,
+    kDagStringBytes,
+    kDagSectionCount
+};
+
+struct DagFileHeader {
+    char magic[8];                      // "HEFTDAG\0"
+    std::uint32_t version;
+    std::uint32_t byteOrder;            // 0x01020304，字节序不同的文件被拒绝
+    std::uint32_t requiredFeatures;     // 读者不认识其中任何一位时拒绝该文件
+    std::uint32_t optionalFeatures;     // 不认识的位可以忽略
+    std::uint64_t fileSize;
+    std::uint32_t taskCount;
+    std::uint32_t stringCount;
+    DagFileSection sections[kDagSectionCount];
+};
+
+// requiredFeatures 的各位
+const std::uint32_t kDagUnaddressedParents = 1;
+
+// 能力位，与 TaskConverter::buildTasks 的 features 一致
+const std::uint32_t kDagBitalu = 1;
+const std::uint32_t kDagSerdiv = 2;
+const std::uint32_t kDagComplexunit = 4;
+
+struct DagTaskRecord {
+    double computationCost;
+    std::uint32_t name;
+    std::uint32_t hardwareinfo;
+    std::uint32_t hash;
+    std::uint32_t capability;           // kDagBitalu | kDagSerdiv | kDagComplexunit
+    std::int32_t spm_size;
+    std::int32_t num_lane;
+    std::int32_t text_offset;
+    std::int32_t data_offset;
+    std::int32_t total_length;
+    std::int32_t text_length;
+    std::int32_t data_length;
+    std::int32_t output_num;
+};
+
+// 父任务下标；kDagNoTask 为原文中的 "-1"，kDagUnknownTask 为文件中不存在的任务名（输出为 0）
+const std::int32_t kDagNoTask = -1;
+const std::int32_t kDagUnknownTask = -2;
+
+struct DagParentRecord {
+    std::int32_t task;
+    std::int32_t port;
+    std::int32_t concatValue;
+    std::uint32_t varName;
+    std::uint32_t destAddressText;
+    std::uint32_t sliceLengthText;
+    std::uint32_t sliceDataTypeText;
+    std::uint32_t sliceDataDest;
+    std::uint64_t bytes;                // slice_length * slice_data_type，通信代价模型使用
+};
+
+inline bool dagParentHasAddress(const DagParentRecord& parent) {
+    return parent.destAddressText != 0;
+}
+
+struct DagGlobalRecord {
+    std::uint32_t name;
+    std::uint32_t destAddress;
+};
+
+struct DagParaRecord {
+    std::uint32_t name;
+    std::uint32_t destAddressText;
+    std::uint32_t sliceLengthText;
+    std::uint32_t sliceDataTypeText;
+    std::uint32_t sliceDataDest;
+};
+
+struct DagReturnRecord {
+    std::uint32_t name;
+    std::int32_t port;
+};
+
+// 只读映射一个 .dag 文件。打开时校验头部、各段边界、CSR 偏移与所有下标，
+// 之后的访问不再检查。不可复制，映射在析构时解除。
+class DagFile {
+public:
+    // 版本 2：DagParentRecord 增加 bytes
+    static const std::uint32_t kVersion = 2;
+
+    // 文件不存在、格式或版本不符、内容越界时抛出 std::runtime_error
+    explicit DagFile(const std::string& path);
+    ~DagFile();
+
+    DagFile(const DagFile&) = delete;
+    DagFile& operator=(const DagFile&) = delete;
+
+    // 只读取魔数，判断文件是否为 .dag 格式
+    static bool isDagFile(const std::string& path);
+
+    // 把解析后的 JSON 任务写为 .dag。父任务按名字解析为下标，重名时与 TaskConverter 一样取最后一个
+    static void write(const std::string& path, const std::vector<inputTask>& inputTasks, const StringPool& pool);
+
+    int taskCount() const { return static_cast<int>(header->taskCount); }
+
+    const DagTaskRecord& task(int index) const { return tasks[index]; }
+
+    const DagParentRecord* parentsBegin(int index) const { return parents + parentOffsets[index]; }
+    const DagParentRecord* parentsEnd(int index) const { return parents + parentOffsets[index + 1]; }
+    const DagGlobalRecord* globalsBegin(int index) const { return globals + globalOffsets[index]; }
+    const DagGlobalRecord* globalsEnd(int index) const { return globals + globalOffsets[index + 1]; }
+    const DagParaRecord* parasBegin(int index) const { return paras + paraOffsets[index]; }
+    const DagParaRecord* parasEnd(int index) const { return paras + paraOffsets[index + 1]; }
+    const DagReturnRecord* returnsBegin(int index) const { return returns + returnOffsets[index]; }
+    const DagReturnRecord* returnsEnd(int index) const { return returns + returnOffsets[index + 1]; }
+
+    int parentCount(int index) const { return static_cast<int>(parentOffsets[index + 1] - parentOffsets[index]); }
+    int globalCount(int index) const { return static_cast<int>(globalOffsets[index + 1] - globalOffsets[index]); }
+    int paraCount(int index) const { return static_cast<int>(paraOffsets[index + 1] - paraOffsets[index]); }
+
+    std::string_view string(std::uint32_t id) const {
+        return std::string_view(stringBytes + stringOffsets[id], stringOffsets[id + 1] - stringOffsets[id]);
+    }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+    const DagFileHeader* header = nullptr;
+    const DagTaskRecord* tasks = nullptr;
+    const std::uint32_t* parentOffsets = nullptr;
+    const DagParentRecord* parents = nullptr;
+    const std::uint32_t* globalOffsets = nullptr;
+    const DagGlobalRecord* globals = nullptr;
+    const std::uint32_t* paraOffsets = nullptr;
+    const DagParaRecord* paras = nullptr;
+    const std::uint32_t* returnOffsets = nullptr;
+    const DagReturnRecord* returns = nullptr;
+    const std::uint32_t* stringOffsets = nullptr;
+    const char* stringBytes = nullptr;
+
+    void validate(const std::string& path);
+};
+
+#endif // DAGFILE_H
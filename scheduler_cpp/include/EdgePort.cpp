@@ -0,0 +1,95 @@
+#include "EdgePort.hpp"
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool parseDigits(std::string_view text, uint32_t base, uint32_t& out) {
+    if (text.empty()) {
+        return false;
+    }
+    uint64_t value = 0;
+    for (char c : text) {
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (base == 16 && c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (base == 16 && c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        value = value * base + digit;
+        if (value > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+uint32_t parseField(const char* name, std::string_view text, uint32_t base) {
+    std::string_view digits = text;
+    if (base == 16 && digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+        digits.remove_prefix(2);
+    }
+    uint32_t value;
+    if (!parseDigits(digits, base, value)) {
+        throw std::invalid_argument(std::string("invalid ") + name + " \"" + std::string(text) + "\"");
+    }
+    return value;
+}
+
+}
+
+EdgePort EdgePort::parse(StringPool& pool, std::string_view destAddress,
+                         std::string_view sliceLength, std::string_view sliceDataType) {
+    EdgePort port;
+    port.destAddressText = pool.intern(destAddress);
+    port.sliceLengthText = pool.intern(sliceLength);
+    port.sliceDataTypeText = pool.intern(sliceDataType);
+    port.hasAddress = destAddress != "null";
+    if (port.hasAddress) {
+        port.destAddress = parseField("dest_address", destAddress, 16);
+    }
+    port.sliceLength = parseField("slice_length", sliceLength, 10);
+    port.sliceDataType = parseField("slice_data_type", sliceDataType, 10);
+    if (!port.hasAddress) {
+        return port;
+    }
+
+    uint64_t dest = port.destAddress + static_cast<uint64_t>(port.sliceLength) * port.sliceDataType;
+    if (dest > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("slice at dest_address \"" + std::string(destAddress) +
+                                    "\" exceeds the 32-bit address space");
+    }
+    port.sliceDataDest = static_cast<uint32_t>(dest);
+    return port;
+}
+
+EdgePort EdgePort::unaddressed(StringPool& pool, std::string_view sliceLength, std::string_view sliceDataType) {
+    EdgePort port;
+    port.destAddressText = pool.intern("null");
+    port.sliceLengthText = pool.intern(sliceLength);
+    port.sliceDataTypeText = pool.intern(sliceDataType);
+    return port;
+}
+
+HexText::HexText(uint32_t value) {
+    static const char digits[] = "0123456789ABCDEF";
+    char reversed[8];
+    int count = 0;
+    do {
+        reversed[count++] = digits[value & 0xF];
+        value >>= 4;
+    } while (value != 0);
+
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    length = 2;
+    while (count > 0) {
+        buffer[length++] = reversed[--count];
+    }
+}
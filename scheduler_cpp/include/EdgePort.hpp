@@ -0,0 +1,43 @@
+#ifndef EDGEPORT_H
+#define EDGEPORT_H
+
+#include <cstdint>
+#include <string_view>
+#include "StringPool.hpp"
+
+// 一个输入端口的目的地址与切片参数。
+// 文本字段原样保留用于输出；数值字段在加载时解析、校验一次，输出阶段不再解析字符串。
+// 子任务边不携带地址，只有文本字段有效，数值字段为 0。
+// dest_address 为 "null" 的父任务边仍是调度依赖（切片字段给出传输字节数），但不写入输出的 all_input。
+struct EdgePort {
+    Symbol destAddressText = 0;
+    Symbol sliceLengthText = 0;
+    Symbol sliceDataTypeText = 0;
+    uint32_t destAddress = 0;       // 十六进制，可带 0x 前缀
+    uint32_t sliceLength = 0;       // 十进制
+    uint32_t sliceDataType = 0;     // 十进制，每个元素的字节数
+    uint32_t sliceDataDest = 0;     // destAddress + sliceLength * sliceDataType
+    bool hasAddress = false;        // dest_address 不为 "null"
+
+    // destAddress 为 "null" 时只解析切片字段。校验失败抛出 std::invalid_argument，消息中带字段名与原始文本
+    static EdgePort parse(StringPool& pool, std::string_view destAddress,
+                          std::string_view sliceLength, std::string_view sliceDataType);
+
+    static EdgePort unaddressed(StringPool& pool, std::string_view sliceLength, std::string_view sliceDataType);
+};
+
+// "0x" + 大写十六进制，写入内部缓冲区，不分配内存
+class HexText {
+public:
+    explicit HexText(uint32_t value);
+
+    std::string_view view() const {
+        return std::string_view(buffer, length);
+    }
+
+private:
+    char buffer[2 + 8];
+    int length;
+};
+
+#endif // EDGEPORT_H
@@ -1,329 +1,608 @@
 #include "HEFTPlanningAlgorithm.hpp"
+#include "SimdKernels.hpp"
+#include "Trace.hpp"
 #include <algorithm>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <stdexcept>
 
+namespace {
 
-double HEFTPlanningAlgorithm::calculateAverageBandwidth() {
-    std::cout << "HEFT calculateAverageBandwidth\n";
-    double avg = 0.0;
-    for (const auto& tile : tiles) {
-        avg += tile.computationCapacity;
+// TILE 数少于该值时分片与同步的开销大于收益，直接串行评估
+const int kParallelTileThreshold = 16;
+
+// "N task(s) <what>: id id ..."，最多列出 10 个
+std::string taskListMessage(const std::vector<int>& taskIds, const char* what) {
+    std::ostringstream message;
+    message << taskIds.size() << " task(s) " << what << ":";
+    for (std::size_t i = 0; i < taskIds.size() && i < 10; ++i) {
+        message << " " << taskIds[i];
     }
-    return avg / tiles.size();
-}
-void HEFTPlanningAlgorithm::calculateComputationCosts(const std::vector<Task>& tasks, const std::vector<Tile>& tiles) {
-    std::cout << "HEFT calculateComputationCosts\n";
-    for (const auto& task : tasks) {
-        std::map<int, double> costsTile;
-        for (const auto& tile : tiles) {
-            if (tile.computationCapacity < task.computationCost) {
-                costsTile[tile.tileId] = std::numeric_limits<double>::infinity();
-            } else {
-                costsTile[tile.tileId] = task.computationCost / tile.computationCapacity;
-            }
-        }
-        computationCosts[task.taskId] = costsTile;
+    if (taskIds.size() > 10) {
+        message << " ...";
     }
+    return message.str();
+}
 
+}
 
-    for (const auto& task : tasks) {
-        std::map<int, double> costsTile;
-        for (const auto& tile : tiles) {
-            double computationCost = computationCosts[task.taskId][tile.tileId];
-            // std::cout << "任务 " << task.taskId << " 在 TILE " << tile.tileId << " 上的用时：" << computationCost << "\n";
-        }
-        
+void HEFTPlanningAlgorithm::buildTaskGraph(const std::vector<Task>& tasks, const std::vector<Tile>& tiles) {
+    PhaseTimer timer(TracePhase::CostTables);
+    TaskGraph::build(tasks, tiles, dag, &scratch);
+    prepareTaskGraph();
+}
+
+void HEFTPlanningAlgorithm::buildTaskGraph(const DagFile& file) {
+    PhaseTimer timer(TracePhase::CostTables);
+    TaskGraph::build(file, tiles, dag, &scratch);
+    prepareTaskGraph();
+}
+
+void HEFTPlanningAlgorithm::prepareTaskGraph() {
+    tileReady.assign(dag.numTiles, 0.0);
+    tileStarts.assign(dag.numTiles, 0.0);
+    tileCosts.assign(dag.numTiles, 0.0);
+    tileFinish.assign(dag.numTiles, 0.0);
+    tileScore.assign(dag.numTiles, 0.0);
+
+    // 没有任何匹配 TILE 的任务在规划开始前统一报告
+    if (!dag.unmatchedTasks.empty()) {
+        throw std::runtime_error(taskListMessage(dag.unmatchedTasks, "match no tile"));
+    }
+    // 匹配的 TILE 算力都不足时同样拒绝：完成时间为无穷，写入时间线会污染该 TILE 上后续的任务
+    if (!dag.infeasibleTasks.empty()) {
+        throw std::invalid_argument(
+            taskListMessage(dag.infeasibleTasks, "exceed the computationCapacity of every matching tile"));
     }
 }
-void HEFTPlanningAlgorithm::calculateTransferCosts(const std::vector<Task>& tasks) {
-    // std::cout << "HEFT calculateTransferCosts\n";
-    for (const auto& parent : tasks) {
-        std::map<int, double> taskTransferCosts;
-        for (const auto& child : tasks) {
-            taskTransferCosts[child.taskId] = calculateTransferCost(parent, child);
+
+void HEFTPlanningAlgorithm::computeTopologicalOrder() {
+    if (!dag.topologicalOrder(topoOrder, &scratch)) {
+        std::ostringstream message;
+        message << "task graph contains a cycle:";
+        std::vector<int> cycle = dag.findCycle();
+        for (int taskId : cycle) {
+            message << " " << taskId << " ->";
         }
-        transferCosts[parent.taskId] = taskTransferCosts;
-    }
-}
-double HEFTPlanningAlgorithm::calculateTransferCost(const Task& parent, const Task& child) {
-    // std::cout << "HEFT calculateTransferCost\n";
-    double acc = 0.0;
-    for (const auto& parentFile : parent.childTasks) {
-        if (std::get<0>(parentFile) != -1) {
-            for (const auto& childFile : child.parentTasks) {
-                if (std::get<0>(childFile)!= -1 && std::get<0>(parentFile) == std::get<0>(childFile)) {
-                    acc += 1.0; // 假设传输成本是常量
-                    break;
-                }
-            }
+        message << " " << cycle.front();
+        throw std::runtime_error(message.str());
+    }
+    topoPosition.resize(dag.numTasks);
+    for (int i = 0; i < dag.numTasks; ++i) {
+        topoPosition[topoOrder[i]] = i;
+    }
+}
+
+void HEFTPlanningAlgorithm::calculateRanks() {
+    PhaseTimer timer(TracePhase::Rank);
+    computeTopologicalOrder();
+
+    // 逆拓扑序单次扫描：处理某任务时其所有子任务的 rank 均已算出
+    rank.assign(dag.numTasks, 0.0);
+    tileBias.clear();
+    for (auto it = topoOrder.rbegin(); it != topoOrder.rend(); ++it) {
+        int taskId = *it;
+        double maxChildCost = 0.0;
+        for (int e = dag.childOffsets[taskId]; e < dag.childOffsets[taskId + 1]; ++e) {
+            maxChildCost = std::max(maxChildCost, comm->averageCost(dag.childBytes[e]) + rank[dag.childIds[e]]);
         }
+        rank[taskId] = averageComputationCost(taskId) + maxChildCost;
     }
-    return acc;
+    sortByRank();
 }
 
-bool HEFTPlanningAlgorithm::compareRank(const std::pair<int, double>& a, const std::pair<int, double>& b) {
-    return a.second > b.second;
+void HEFTPlanningAlgorithm::sortByRank() {
+    // 按 rank 降序排列，rank 相同时按拓扑序，保证结果确定且父任务在前
+    rankVector.resize(dag.numTasks);
+    for (int t = 0; t < dag.numTasks; ++t) {
+        rankVector[t] = {t, rank[t]};
+    }
+    std::sort(rankVector.begin(), rankVector.end(),
+              [this](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+                  if (a.second != b.second) {
+                      return a.second > b.second;
+                  }
+                  return topoPosition[a.first] < topoPosition[b.first];
+              });
 }
 
-void HEFTPlanningAlgorithm::calculateRanks(const std::vector<Task>& tasks) {
-    // std::cout << "HEFT calculateRanks\n";
-    std::map<int, std::vector<int>> graph; // 父任务到子任务的关系
-    std::map<int, int> inDegree;           // 任务的入度
-    std::map<int, int> ranks;              // 任务的 rank
+double HEFTPlanningAlgorithm::averageComputationCost(int taskId) const {
+    return dag.averageCosts[taskId];
+}
 
-    for (const auto& task : tasks) {
-        for (const auto& parentTasks : task.parentTasks) {
-            int parentID = std::get<0>(parentTasks);
-            int childID = task.taskId;
-            graph[parentID].push_back(childID);
-            inDegree[childID]++;
-            if (inDegree.find(parentID) == inDegree.end()) {
-                inDegree[parentID] = 0; // 父任务可能没有被子任务引用
-            }
-        }
+void HEFTPlanningAlgorithm::allocateTasks() {
+    PhaseTimer timer(TracePhase::Allocate);
+    earliestFinishTimes.assign(dag.numTasks, 0.0);
+    taskEvents.assign(dag.numTasks, Event{-1, -1, 0.0, 0.0});
+    taskTiles.assign(dag.numTasks, -1);
+    for (auto& timeline : timelines) {
+        timeline.clear();
+    }
+    if (contention) {
+        links.clear();
+    }
 
-    std::queue<int> q;
-    for (const auto& [taskID, degree] : inDegree) {
-        if (degree == 0) {
-            q.push(taskID);
-            ranks[taskID] = inDegree.size(); // 根节点 rank 最大
-        }
+    computeAllocationOrder();
+    for (int taskId : allocationOrder) {
+        allocateTask(taskId);
     }
+    collectSchedules();
+}
 
-    // 拓扑排序处理，更新 ranks
-    while (!q.empty()) {
-        int current = q.front();
-        q.pop();
-        int currentRank = ranks[current];
+void HEFTPlanningAlgorithm::computeAllocationOrder() {
+    // 就绪队列：rank 高者优先，rank 相同按拓扑序；所有父任务分配完成后子任务才入队。
+    // 出队顺序与分配结果无关，因此可以先于分配单独求出
+    auto lowerPriority = [this](int a, int b) {
+        if (rank[a] != rank[b]) {
+            return rank[a] < rank[b];
+        }
+        return topoPosition[a] > topoPosition[b];
+    };
+    std::priority_queue<int, std::pmr::vector<int>, decltype(lowerPriority)> ready(
+        lowerPriority, std::pmr::vector<int>(&scratch));
+    std::pmr::vector<int> inDegree(dag.numTasks, &scratch);
+    for (int t = 0; t < dag.numTasks; ++t) {
+        inDegree[t] = dag.parentCount(t);
+        if (inDegree[t] == 0) {
+            ready.push(t);
+        }
+    }
 
-        for (const auto& child : graph[current]) {
-            inDegree[child]--;
-            if (inDegree[child] == 0) {
-                q.push(child);
-                ranks[child] = currentRank - 1; // 子任务 rank 比父任务低
+    allocationOrder.clear();
+    allocationOrder.reserve(dag.numTasks);
+    while (!ready.empty()) {
+        int taskId = ready.top();
+        ready.pop();
+        allocationOrder.push_back(taskId);
+        for (int e = dag.childOffsets[taskId]; e < dag.childOffsets[taskId + 1]; ++e) {
+            if (--inDegree[dag.childIds[e]] == 0) {
+                ready.push(dag.childIds[e]);
             }
         }
     }
+}
 
-    // 输出结果
-    for (const auto& [taskID, rank] : ranks) {
-        std::cout << "Task ID: " << taskID << ", Rank: " << rank << std::endl;
+void HEFTPlanningAlgorithm::collectSchedules() {
+    // 事件按分配顺序追加，最后一次性按开始时间排序
+    for (auto& entry : schedules) {
+        entry.second.clear();
     }
-
+    for (int taskId : allocationOrder) {
+        schedules[taskEvents[taskId].tileId].push_back(taskEvents[taskId]);
     }
-
-    for (const auto& task : tasks) {
-        epsilon = ranks[task.taskId];
-        
-        calculateRank(task);
+    for (auto& entry : schedules) {
+        std::stable_sort(entry.second.begin(), entry.second.end(), [](const Event& a, const Event& b) {
+            return a.start < b.start;
+        });
     }
-    // std::cout << "okkk1\n";
-    rankVector.assign(rank.begin(), rank.end());
-    std::sort(rankVector.begin(), rankVector.end(), compareRank);
-    std::map<int, double> rankMap;
+}
 
-    // 遍历 rankVector，并将每个元素插入到 rankMap 中
-    for (const auto& pair : rankVector) {
-        rankMap[pair.first] = pair.second;
+void HEFTPlanningAlgorithm::allocateTask(int taskId) {
+    HEFT_TRACE_COUNT(TasksAllocated, 1);
+
+    // 只评估与任务能力类一致的 TILE（buildTaskGraph 已保证每个任务至少有一个可执行的）
+    int taskClass = dag.taskClass[taskId];
+    int bucketBegin = dag.classTileOffsets[taskClass];
+    int bucketEnd = dag.classTileOffsets[taskClass + 1];
+
+    TileChoice best;
+    if (workerPool != nullptr && workerPool->size() > 1 && bucketEnd - bucketBegin >= kParallelTileThreshold) {
+        // 各线程只读地评估自己那一段 TILE，再按 (得分, tileId) 做确定性归约
+        HEFT_TRACE_COUNT(ParallelTasks, 1);
+        shardChoices.assign(workerPool->size(), TileChoice());
+        auto job = [this, taskId, bucketBegin](int shard, int begin, int end) {
+            shardChoices[shard] = evaluateTiles(taskId, bucketBegin + begin, bucketBegin + end);
+        };
+        workerPool->parallelFor(bucketEnd - bucketBegin, job);
+        for (const auto& choice : shardChoices) {
+            if (isBetterChoice(choice, best)) {
+                best = choice;
+            }
+        }
+    } else {
+        best = evaluateTiles(taskId, bucketBegin, bucketEnd);
     }
+    double ready = contention ? bookTransfers(taskId, best.tile) : best.ready;
+    earliestFinishTimes[taskId] = findFinishTime(taskId, best.tile, ready, true);
 }
 
-
-double HEFTPlanningAlgorithm::calculateRank(const Task& task) {
-    if (rank.count(task.taskId) > 0) {
-        return rank[task.taskId];
+HEFTPlanningAlgorithm::TileChoice HEFTPlanningAlgorithm::evaluateTiles(int taskId, int begin, int end) {
+    // [begin, end) 是 dag.classTiles 中的位置。就绪时间按父边逐条取通信代价矩阵中源 TILE 的一行累积 max，
+    // 各 TILE 的最早开始时间逐个查时间线，完成时间、得分与 argmin 沿 TILE 维度向量化
+    TileChoice best;
+    if (begin >= end) {
+        return best;
     }
-
-    // 检查任务是否已经在当前计算中，如果是则返回一个合理的值，防止无限递归
-    if (currentlyCalculating.count(task.taskId) > 0) {
-        return 0.0;  // 或者使用其他适当的默认值
+    HEFT_TRACE_COUNT(TilesEvaluated, end - begin);
+    std::fill(tileReady.begin() + begin, tileReady.begin() + end, 0.0);
+    for (int e = dag.parentOffsets[taskId]; e < dag.parentOffsets[taskId + 1]; ++e) {
+        int parentId = dag.parentIds[e];
+        int source = taskTiles[parentId];
+        double parentFinish = earliestFinishTimes[parentId];
+        double bytes = dag.parentBytes[e];
+        if (contention) {
+            // 各父边只与已预约的传输竞争，本任务入边之间的竞争在 bookTransfers 中才计入
+            for (int i = begin; i < end; ++i) {
+                tileReady[i] = std::max(tileReady[i], links.arrival(source, dag.classTiles[i], parentFinish, bytes));
+            }
+            continue;
+        }
+        const double* latency = comm->latencyRow(source);
+        const double* perByte = comm->perByteRow(source);
+        for (int i = begin; i < end; ++i) {
+            int tile = dag.classTiles[i];
+            tileReady[i] = std::max(tileReady[i], parentFinish + (latency[tile] + bytes * perByte[tile]));
+        }
     }
-
-    // 将任务添加到当前计算中
-    currentlyCalculating.insert(task.taskId);
-    // std::cout << "okkk2\n";
-    double averageComputationCost = 0.0;
-    for (const auto& cost : computationCosts[task.taskId]) {
-        if (cost.second != std::numeric_limits<double>::infinity()) {
-            averageComputationCost += cost.second;
+    const double* costs = dag.computationRow(taskId);
+    for (int i = begin; i < end; ++i) {
+        int tile = dag.classTiles[i];
+        tileCosts[i] = costs[tile];
+        tileStarts[i] = timelines[tile].earliestStart(tileReady[i], costs[tile]);
+    }
+    const int count = end - begin;
+    int choice = begin + SimdKernels::addArgmin(&tileStarts[begin], &tileCosts[begin], &tileFinish[begin], count);
+    const double* score = tileFinish.data();
+    if (!tileBias.empty()) {
+        const double* bias = tileBias.data() + static_cast<std::size_t>(taskId) * dag.numTiles;
+        for (int i = begin; i < end; ++i) {
+            tileCosts[i] = bias[dag.classTiles[i]];
         }
+        choice = begin + SimdKernels::addArgmin(&tileFinish[begin], &tileCosts[begin], &tileScore[begin], count);
+        score = tileScore.data();
     }
-
-    // std::cout << "-------- " << "\n";
-    averageComputationCost /= computationCosts[task.taskId].size();
-    // std::cout << "okkk3\n";
-    double maxChildCost = 0.0;
-
-    for (const auto& childId : task.childTasks) {
-        // std::cout << "task " << task.taskId << "childId " << childId << "\n";
-        if (std::get<0>(childId)!=-1) {  // 检查 tasks 是否包含 childId
-            double childCost = transferCosts[task.taskId][std::get<0>(childId)] + calculateRank(tasks[std::get<0>(childId)]) + epsilon;
-            maxChildCost = std::max(maxChildCost, childCost);
+    if (!tileIdsAscending) {
+        for (int i = choice + 1; i < end; ++i) {
+            if (score[i] == score[choice] && tiles[dag.classTiles[i]].tileId < tiles[dag.classTiles[choice]].tileId) {
+                choice = i;
+            }
         }
     }
-    
-    // 从当前计算集合中移除任务
-    currentlyCalculating.erase(task.taskId);
+    best.tile = dag.classTiles[choice];
+    best.ready = tileReady[choice];
+    best.finish = tileFinish[choice];
+    best.score = score[choice];
+    return best;
+}
 
-    rank[task.taskId] = averageComputationCost + maxChildCost;
-    return rank[task.taskId];
+bool HEFTPlanningAlgorithm::isBetterChoice(const TileChoice& candidate, const TileChoice& best) const {
+    // 得分（HEFT 即完成时间）更小者优先，相同则 tileId 小者优先
+    if (candidate.tile < 0) {
+        return false;
+    }
+    if (best.tile < 0) {
+        return true;
+    }
+    if (candidate.score != best.score) {
+        return candidate.score < best.score;
+    }
+    return tiles[candidate.tile].tileId < tiles[best.tile].tileId;
 }
 
-void HEFTPlanningAlgorithm::allocateTasks(const std::vector<Task>& tasks, const std::vector<Tile>& tiles) {
-    // std::cout << "HEFT allocateTasks\n";
-    std::vector<Task> sortedTasks = tasks;
-    std::sort(sortedTasks.begin(), sortedTasks.end(), [this](const Task& a, const Task& b) {
-        // Custom sorting function
-        return compareTasks(a, b);
-    });
-    for (const auto& task : sortedTasks) {
-        allocateTask(task);
+double HEFTPlanningAlgorithm::bookTransfers(int taskId, int tileIndex) {
+    // 先完成的父任务先占用链路；完成时间相同时按父边顺序，保证结果确定
+    transferOrder.clear();
+    for (int e = dag.parentOffsets[taskId]; e < dag.parentOffsets[taskId + 1]; ++e) {
+        transferOrder.push_back({earliestFinishTimes[dag.parentIds[e]], e});
     }
+    std::sort(transferOrder.begin(), transferOrder.end());
+    double ready = 0.0;
+    for (const auto& transfer : transferOrder) {
+        int e = transfer.second;
+        ready = std::max(ready, links.book(taskTiles[dag.parentIds[e]], tileIndex, transfer.first, dag.parentBytes[e]));
+    }
+    return ready;
 }
 
-bool HEFTPlanningAlgorithm::compareTasks(const Task& a, const Task& b)  {
-    // Check if a has any unresolved dependencies
-    for (const auto& dependency : a.parentTasks) {
-        if (earliestFinishTimes.find(std::get<0>(dependency)) == earliestFinishTimes.end()) {
-            // a has an unresolved dependency, so it should come after b
-            return false;
-        }
+double HEFTPlanningAlgorithm::findFinishTime(int taskId, int tileIndex, double readyTime, bool occupySlot) {
+    double computationCost = dag.computationCost(taskId, tileIndex);
+    double start = timelines[tileIndex].earliestStart(readyTime, computationCost);
+    double finish = start + computationCost;
+    if (occupySlot) {
+        timelines[tileIndex].occupy(start, finish);
+        taskEvents[taskId] = {taskId, tiles[tileIndex].tileId, start, finish};
+        taskTiles[taskId] = tileIndex;
     }
+    return finish;
+}
 
-    // Check if b has any unresolved dependencies
-    for (const auto& dependency : b.parentTasks) {
-        if (earliestFinishTimes.find(std::get<0>(dependency)) == earliestFinishTimes.end()) {
-            // b has an unresolved dependency, so it should come after a
-            return true;
-        }
+
+const char* HEFTPlanningAlgorithm::name() const {
+    return "heft";
+}
+
+void HEFTPlanningAlgorithm::setWorkerPool(WorkerPool* pool) {
+    workerPool = pool;
+}
+
+HEFTPlanningAlgorithm::HEFTPlanningAlgorithm(const std::vector<Task>& taskList, const std::vector<Tile>& tileList,
+                                             std::shared_ptr<const CommModel> commModel)
+    : tasks(taskList), tiles(tileList), comm(std::move(commModel)) {
+    if (!comm) {
+        comm = std::make_shared<const CommModel>(tiles, MeshTopology());
+    } else if (comm->tileCount() != static_cast<int>(tiles.size())) {
+        throw std::invalid_argument("communication model is for a different number of tiles");
+    }
+    for (const auto& tile : tiles) {
+        schedules[tile.tileId] = std::vector<Event>();
     }
+    timelines.resize(tiles.size());
+    contention = comm->topology().contention;
+    if (contention) {
+        links.reset(*comm);
+    }
+    for (std::size_t p = 1; p < tiles.size(); ++p) {
+        tileIdsAscending = tileIdsAscending && tiles[p - 1].tileId < tiles[p].tileId;
+    }
+}
 
-    // Both tasks have resolved dependencies, compare their ranks
-    return rank[a.taskId] > rank[b.taskId];
+void HEFTPlanningAlgorithm::run() {
+    scratch.reset();
+    buildTaskGraph(tasks, tiles);
+    calculateRanks();
+    allocateTasks();
+    planned = true;
 }
 
+void HEFTPlanningAlgorithm::run(const DagFile& file) {
+    // 规划只用到 TaskGraph，任务列表留空
+    tasks.clear();
+    planned = false;
+    scratch.reset();
+    buildTaskGraph(file);
+    calculateRanks();
+    allocateTasks();
+    planned = true;
+}
 
-bool HEFTPlanningAlgorithm::checkTaskTileMatch(const Task& task, const Tile& tile) {
-    // 获取任务和瓦片的属性
-    return (task.spm_size == tile.spm_size &&
-            task.num_lane == tile.num_lane &&
-            task.has_bitalu == tile.has_bitalu &&
-            task.has_serdiv == tile.has_serdiv &&
-            task.has_complexunit == tile.has_complexunit);
+void HEFTPlanningAlgorithm::reset(const std::vector<Task>& taskList) {
+    // 逐元素赋值，任务及其边数组沿用原有容量
+    tasks = taskList;
+    planned = false;
+    scratch.reset();
 }
 
-void HEFTPlanningAlgorithm::allocateTask(const Task& task) {
-    std::cout << "HEFT allocateTask\n";
-    Tile chosenTile;
-    double earliestFinishTime = std::numeric_limits<double>::infinity();
-    double bestReadyTime = 0.0;
-    double finishTime;
+std::vector<int> HEFTPlanningAlgorithm::applyDelta(const TaskDelta& delta, std::vector<char>& rankSeeds,
+                                                   std::vector<char>& placementSeeds) {
+    // 先在扩展编号（旧任务 + 新增任务）上修改，最后删除任务并重新编号
+    const int oldCount = static_cast<int>(tasks.size());
+    const int extended = oldCount + static_cast<int>(delta.addedTasks.size());
+    auto checkId = [extended](int id, const char* field) {
+        if (id < 0 || id >= extended) {
+            throw std::invalid_argument(std::string(field) + " refers to unknown task " + std::to_string(id));
+        }
+    };
+
+    // rank 受影响：自身代价或子边变化；分配受影响：自身代价或父边变化
+    std::vector<char> rankSeed(extended, 0);
+    std::vector<char> placementSeed(extended, 0);
+    std::vector<char> removed(extended, 0);
+    for (int id : delta.removedTasks) {
+        checkId(id, "removedTasks");
+        removed[id] = 1;
+    }
 
-    for (const auto& tile : tiles) {
-        // 检查任务和瓦片的属性是否匹配
-        if (checkTaskTileMatch(task, tile)) {
-            double minReadyTime = 0.0;
-            for (const auto& parent : task.parentTasks) {
-                double readyTime = earliestFinishTimes[std::get<0>(parent)];
-                if (std::get<0>(parent) != task.taskId) {
-                    readyTime += transferCosts[std::get<0>(parent)][task.taskId];
-                }
-                minReadyTime = std::max(minReadyTime, readyTime);
+    // 原有的越界父/子引用本来就被忽略，统一记为 -1，避免与新增任务的编号混淆
+    for (auto& task : tasks) {
+        for (auto& parent : task.parentTasks) {
+            if (parent.taskId >= oldCount) {
+                parent.taskId = -1;
             }
-            finishTime = findFinishTime(task, tile, minReadyTime, false);
-            if (finishTime < earliestFinishTime) {
-                bestReadyTime = minReadyTime;
-                earliestFinishTime = finishTime;
-                chosenTile = tile;
+        }
+        for (auto& child : task.childTasks) {
+            if (child.taskId >= oldCount) {
+                child.taskId = -1;
             }
         }
     }
+    for (std::size_t k = 0; k < delta.addedTasks.size(); ++k) {
+        Task task = delta.addedTasks[k];
+        task.taskId = oldCount + static_cast<int>(k);
+        task.parentTasks.clear();
+        task.childTasks.clear();
+        rankSeed[task.taskId] = placementSeed[task.taskId] = 1;
+        tasks.push_back(std::move(task));
+    }
+    for (const auto& change : delta.changedCosts) {
+        checkId(change.first, "changedCosts");
+        tasks[change.first].computationCost = change.second;
+        rankSeed[change.first] = placementSeed[change.first] = 1;
+    }
+    for (const auto& edge : delta.removedEdges) {
+        checkId(edge.first, "removedEdges");
+        checkId(edge.second, "removedEdges");
+        auto& parents = tasks[edge.second].parentTasks;
+        parents.erase(std::remove_if(parents.begin(), parents.end(),
+                                     [&edge](const PortEdge<int>& p) { return p.taskId == edge.first; }),
+                      parents.end());
+        auto& children = tasks[edge.first].childTasks;
+        children.erase(std::remove_if(children.begin(), children.end(),
+                                      [&edge](const PortEdge<int>& c) { return c.taskId == edge.second; }),
+                       children.end());
+        rankSeed[edge.first] = 1;
+        placementSeed[edge.second] = 1;
+    }
+    for (const auto& edge : delta.addedEdges) {
+        checkId(edge.first, "addedEdges");
+        checkId(edge.second, "addedEdges");
+        tasks[edge.second].parentTasks.push_back({edge.first, 0, EdgePort(), 0, 0});
+        tasks[edge.first].childTasks.push_back({edge.second, 0, EdgePort(), 0, 0});
+        rankSeed[edge.first] = 1;
+        placementSeed[edge.second] = 1;
+    }
 
-    findFinishTime(task, chosenTile, bestReadyTime, true);
-    earliestFinishTimes[task.taskId] = earliestFinishTime;
-    // std::cout << "任务 " << task.taskId << " 分配给 TILE " << chosenTile.tileId << "，最早完成时间：" << earliestFinishTime << "\n";
-}
-
-double HEFTPlanningAlgorithm::findFinishTime(const Task& task, const Tile& tile, double readyTime, bool occupySlot) {
-    std::cout << "HEFT findFinishTime\n";
-    std::vector<Event>& sched = schedules[tile.tileId];
-    double computationCost = computationCosts[task.taskId][tile.tileId];
-    double start, finish;
-    int pos;
-    if (sched.empty()) {
-        if (occupySlot) {
-            sched.push_back({task.taskId,tile.tileId,readyTime, readyTime + computationCost});
+    std::vector<int> newId(extended, -1);
+    if (delta.removedTasks.empty()) {
+        for (int id = 0; id < extended; ++id) {
+            newId[id] = id;
         }
-        return readyTime + computationCost;
-    }
-    if (sched.size() == 1) {
-        if (readyTime >= sched[0].finish) {
-            pos = 1;
-            start = readyTime;
-        } else if (readyTime + computationCost <= sched[0].start) {
-            pos = 0;
-            start = readyTime;
+        rankSeeds = std::move(rankSeed);
+        placementSeeds = std::move(placementSeed);
+        return newId;
+    }
+    int count = 0;
+    for (int id = 0; id < extended; ++id) {
+        if (!removed[id]) {
+            newId[id] = count++;
         } else {
-            pos = 1;
-            start = sched[0].finish;
+            for (const auto& parent : tasks[id].parentTasks) {
+                if (parent.taskId >= 0 && !removed[parent.taskId]) {
+                    rankSeed[parent.taskId] = 1;
+                }
+            }
         }
-        if (occupySlot) {
-            sched.insert(sched.begin() + pos, {task.taskId, tile.tileId, start, start + computationCost});
+    }
+
+    std::vector<Task> kept;
+    kept.reserve(count);
+    rankSeeds.assign(count, 0);
+    placementSeeds.assign(count, 0);
+    for (int id = 0; id < extended; ++id) {
+        if (removed[id]) {
+            continue;
         }
-        return start + computationCost;
-    }
-    start = std::max(readyTime, sched[sched.size() - 1].finish);
-    finish = start + computationCost;
-    int i = sched.size() - 1;
-    int j = sched.size() - 2;
-    pos = i + 1;
-    while (j >= 0) {
-        Event current = sched[i];
-        Event previous = sched[j];
-        if (readyTime > previous.finish) {
-            if (readyTime + computationCost <= current.start) {
-                start = readyTime;
-                finish = readyTime + computationCost;
-                pos = i;
+        Task& task = tasks[id];
+        task.taskId = newId[id];
+        auto& parents = task.parentTasks;
+        for (auto it = parents.begin(); it != parents.end();) {
+            if (it->taskId >= 0 && removed[it->taskId]) {
+                it = parents.erase(it);
+                placementSeed[id] = 1;
+            } else {
+                if (it->taskId >= 0) {
+                    it->taskId = newId[it->taskId];
+                }
+                ++it;
             }
-            break;
-        }
-        if (previous.finish + computationCost <= current.start) {
-            start = previous.finish;
-            finish = previous.finish + computationCost;
-            pos = i;
         }
-        i--;
-        j--;
-    }
-    if (readyTime + computationCost <= sched[0].start) {
-        pos = 0;
-        start = readyTime;
-        if (occupySlot) {
-            sched.insert(sched.begin() + pos, {task.taskId, tile.tileId, start, start + computationCost});
+        auto& children = task.childTasks;
+        children.erase(std::remove_if(children.begin(), children.end(),
+                                      [&removed](const PortEdge<int>& c) { return c.taskId >= 0 && removed[c.taskId]; }),
+                       children.end());
+        for (auto& child : children) {
+            if (child.taskId >= 0) {
+                child.taskId = newId[child.taskId];
+            }
         }
-        return start + computationCost;
-    }
-    if (occupySlot) {
-        sched.insert(sched.begin() + pos, {task.taskId, tile.tileId, start, finish});
+        rankSeeds[task.taskId] = rankSeed[id];
+        placementSeeds[task.taskId] = placementSeed[id];
+        kept.push_back(std::move(task));
     }
-    return finish;
+    tasks = std::move(kept);
+    return newId;
 }
 
+int HEFTPlanningAlgorithm::replan(const TaskDelta& delta) {
+    if (planned && static_cast<int>(tasks.size()) != dag.numTasks) {
+        throw std::runtime_error("replan needs a planner that ran on a task list, not a .dag file");
+    }
+    std::vector<char> rankSeeds;
+    std::vector<char> placementSeeds;
+    std::vector<int> newId = applyDelta(delta, rankSeeds, placementSeeds);
+    if (!planned) {
+        run();
+        return dag.numTasks;
+    }
+    planned = false;
+    scratch.reset();
+
+    std::vector<double> oldRank = std::move(rank);
+    std::vector<int> oldOrder = std::move(allocationOrder);
+    std::vector<Event> oldEvents = std::move(taskEvents);
+    std::vector<int> oldTiles = std::move(taskTiles);
+    std::vector<double> oldFinish = std::move(earliestFinishTimes);
+
+    buildTaskGraph(tasks, tiles);
+    const int n = dag.numTasks;
+    {
+        PhaseTimer timer(TracePhase::Rank);
+        computeTopologicalOrder();
+
+        // 未受影响的任务沿用旧 rank；新增任务记为 NaN，保证第一次重算时判定为已变化
+        rank.assign(n, std::numeric_limits<double>::quiet_NaN());
+        for (std::size_t old = 0; old < oldRank.size(); ++old) {
+            if (newId[old] >= 0) {
+                rank[newId[old]] = oldRank[old];
+            }
+        }
+
+        // 按逆拓扑序处理：任务出堆时其受影响的子任务都已重算；rank 不变则不再向上传播
+        std::priority_queue<std::pair<int, int>> pending;
+        std::vector<char> queued(n, 0);
+        for (int t = 0; t < n; ++t) {
+            if (rankSeeds[t]) {
+                queued[t] = 1;
+                pending.push({topoPosition[t], t});
+            }
+        }
+        while (!pending.empty()) {
+            int taskId = pending.top().second;
+            pending.pop();
+            double maxChildCost = 0.0;
+            for (int e = dag.childOffsets[taskId]; e < dag.childOffsets[taskId + 1]; ++e) {
+                maxChildCost = std::max(maxChildCost, comm->averageCost(dag.childBytes[e]) + rank[dag.childIds[e]]);
+            }
+            double updated = averageComputationCost(taskId) + maxChildCost;
+            if (updated == rank[taskId]) {
+                continue;
+            }
+            rank[taskId] = updated;
+            for (int e = dag.parentOffsets[taskId]; e < dag.parentOffsets[taskId + 1]; ++e) {
+                int parentId = dag.parentIds[e];
+                if (!queued[parentId]) {
+                    queued[parentId] = 1;
+                    pending.push({topoPosition[parentId], parentId});
+                }
+            }
+        }
+        sortByRank();
+    }
 
-HEFTPlanningAlgorithm::HEFTPlanningAlgorithm(const std::vector<Task>& taskList, const std::vector<Tile>& tileList)
-    : tasks(taskList), tiles(tileList), averageBandwidth(calculateAverageBandwidth()) {
-    // std::cout << "HEFT HEFTPlanningAlgorithm\n";
-    for (const auto& tile : tiles) {
-        schedules[tile.tileId] = std::vector<Event>();
+    PhaseTimer timer(TracePhase::Allocate);
+    computeAllocationOrder();
+
+    // 分配顺序的公共前缀中未受影响的任务，其放置与上一次完全相同
+    int prefix = 0;
+    while (prefix < n && prefix < static_cast<int>(oldOrder.size())) {
+        int taskId = allocationOrder[prefix];
+        if (placementSeeds[taskId] || newId[oldOrder[prefix]] != taskId) {
+            break;
+        }
+        ++prefix;
     }
-}
 
-void HEFTPlanningAlgorithm::run() {
-    // std::cout << "HEFT planner running\n";
-    calculateComputationCosts(tasks, tiles);
-    calculateTransferCosts(tasks);
-    calculateRanks(tasks);
+    earliestFinishTimes.assign(n, 0.0);
+    taskEvents.assign(n, Event{-1, -1, 0.0, 0.0});
+    taskTiles.assign(n, -1);
+    // 前缀任务沿用上一次的放置，时间线由它们的占用区间直接重建
+    std::vector<std::vector<std::pair<double, double>>> busy(tiles.size());
+    for (int i = 0; i < prefix; ++i) {
+        int taskId = allocationOrder[i];
+        int old = oldOrder[i];
+        taskEvents[taskId] = oldEvents[old];
+        taskEvents[taskId].taskId = taskId;
+        taskTiles[taskId] = oldTiles[old];
+        earliestFinishTimes[taskId] = oldFinish[old];
+        busy[oldTiles[old]].push_back({oldEvents[old].start, oldEvents[old].finish});
+    }
+    for (std::size_t p = 0; p < tiles.size(); ++p) {
+        std::sort(busy[p].begin(), busy[p].end());
+        timelines[p].rebuild(busy[p]);
+    }
+    // 链路预约只取决于此前各任务的放置与预约，按原顺序重新预约前缀任务的入边即得到相同的链路状态
+    if (contention) {
+        links.clear();
+        for (int i = 0; i < prefix; ++i) {
+            bookTransfers(allocationOrder[i], taskTiles[allocationOrder[i]]);
+        }
+    }
+    for (int i = prefix; i < n; ++i) {
+        allocateTask(allocationOrder[i]);
+    }
+    collectSchedules();
+    planned = true;
+    return n - prefix;
 }
 const std::vector<Task>& HEFTPlanningAlgorithm::getTasks() const {
     return tasks;
@@ -339,3 +618,39 @@ const std::vector<Tile>& HEFTPlanningAlgorithm::getTILEs() const {
 const std::map<int, std::vector<Event>>& HEFTPlanningAlgorithm::getSchedules() const {
     return schedules;
 }
+
+const std::vector<Event>& HEFTPlanningAlgorithm::getTaskEvents() const {
+    return taskEvents;
+}
+
+const TaskGraph& HEFTPlanningAlgorithm::getTaskGraph() const {
+    return dag;
+}
+
+double HEFTPlanningAlgorithm::getMakespan() const {
+    double makespan = 0.0;
+    for (const auto& event : taskEvents) {
+        makespan = std::max(makespan, event.finish);
+    }
+    return makespan;
+}
+
+double HEFTPlanningAlgorithm::getScheduleLengthRatio() const {
+    // 拓扑序单次扫描求最小代价下的最长路径
+    std::vector<double> pathLength(dag.numTasks, 0.0);
+    double criticalPath = 0.0;
+    for (int taskId : topoOrder) {
+        double minCost = std::numeric_limits<double>::infinity();
+        const double* costs = dag.computationRow(taskId);
+        for (int p = 0; p < dag.numTiles; ++p) {
+            minCost = std::min(minCost, costs[p]);
+        }
+        double start = 0.0;
+        for (int e = dag.parentOffsets[taskId]; e < dag.parentOffsets[taskId + 1]; ++e) {
+            start = std::max(start, pathLength[dag.parentIds[e]]);
+        }
+        pathLength[taskId] = start + minCost;
+        criticalPath = std::max(criticalPath, pathLength[taskId]);
+    }
+    return criticalPath > 0.0 ? getMakespan() / criticalPath : 0.0;
+}
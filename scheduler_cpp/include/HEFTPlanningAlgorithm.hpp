@@ -8,29 +8,66 @@
 #include <queue>
 #include <functional> 
 #include <unordered_map>
+#include <memory>
+#include "Arena.hpp"
+#include "CommModel.hpp"
+#include "EdgePort.hpp"
+#include "LinkSchedule.hpp"
+#include "PlanningAlgorithm.hpp"
+#include "StringPool.hpp"
+#include "TaskGraph.hpp"
+#include "TileTimeline.hpp"
+#include "WorkerPool.hpp"
+
+// 一条数据边（父任务输出 -> 本任务输入，或本任务输出 -> 子任务）。
+// Id 在 inputTask 中为任务名的 Symbol，在 Task 中为任务下标（-1 表示未知任务）。
+template <typename Id>
+struct PortEdge {
+    Id taskId;
+    int port;
+    EdgePort data;
+    int concatValue;
+    Symbol varName;
+};
+
+struct GlobalInput {
+    Symbol name;
+    Symbol destAddress;
+};
+
+struct ParaInput {
+    Symbol name;
+    EdgePort data;
+};
+
+struct ReturnOutput {
+    Symbol name;
+    int port;
+};
+
 struct Task {
     int taskId;
     double computationCost;
-    std::vector<std::tuple<int, int, std::string, int, std::string, std::string, std::string >> parentTasks; // ID, Port Index, Dest_Addr, Concat_value, Slice_length, Slice_datatype, Varname;
-    std::vector<std::tuple<int, int, std::string, int, std::string, std::string, std::string>> childTasks;  
+    std::vector<PortEdge<int>> parentTasks;
+    std::vector<PortEdge<int>> childTasks;
     int spm_size;
     int num_lane;
     bool has_bitalu;
     bool has_serdiv;
     bool has_complexunit;
-    std::string address;
+    Symbol address;
     int length;
-    std::vector<std::pair<std::string, std::string>> global_Input; 
-    std::vector<std::tuple<std::string, std::string, std::string, std::string>> para_Input;
-    std::vector<std::pair<std::string, int>> return_output;
+    std::vector<GlobalInput> global_Input;
+    std::vector<ParaInput> para_Input;
+    std::vector<ReturnOutput> return_output;
     int text_offset;
     int data_offset;
     int total_length;    
     int text_length;    
     int data_length; 
     int output_num; 
-    std::string hardwareinfo;  
-    std::string hash;
+    Symbol hardwareinfo;
+    Symbol hash;
      
 };
 
@@ -45,28 +82,28 @@ struct Tile {
 };
 
 struct inputTask {
-    std::string taskId;
+    Symbol taskId;
     double computationCost;
-    std::vector<std::tuple<std::string, int, std::string, int, std::string, std::string, std::string>> parentTasks; // ID, Port Index, Dest_Addr, Concat_value, Slice_length, Slice_datatype, Varname;
-    std::vector<std::tuple<std::string, int, std::string, int, std::string, std::string, std::string>> childTasks;  
+    std::vector<PortEdge<Symbol>> parentTasks;
+    std::vector<PortEdge<Symbol>> childTasks;
     int spm_size;
     int num_lane;
     bool has_bitalu;
     bool has_serdiv;
     bool has_complexunit;
-    std::string address;
+    Symbol address;
     int length;
-    std::vector<std::pair<std::string, std::string>> global_Input; 
-    std::vector<std::tuple<std::string, std::string, std::string, std::string>> para_Input;
-    std::vector<std::pair<std::string, int>> return_output;
+    std::vector<GlobalInput> global_Input;
+    std::vector<ParaInput> para_Input;
+    std::vector<ReturnOutput> return_output;
     int text_offset;
     int data_offset;
     int total_length;    
     int text_length;    
     int data_length; 
     int output_num;
-    std::string hardwareinfo;
-    std::string hash;
+    Symbol hardwareinfo;
+    Symbol hash;
 };
 
 struct Event {
@@ -76,58 +113,136 @@ struct Event {
     double finish;
 };
 
-class HEFTPlanningAlgorithm {
-private:
+// DAG 的增量变化（见 HEFTPlanningAlgorithm::replan）。任务下标按变化前的编号，新增任务依次编号为
+// 变化前的任务数 + k，可在同一个 delta 的边中引用。删除的任务被移除，其余任务保持相对顺序重新连续编号。
+struct TaskDelta {
+    std::vector<int> removedTasks;
+    std::vector<Task> addedTasks;                   // 其 parentTasks / childTasks 被忽略，边由 addedEdges 给出
+    std::vector<std::pair<int, int>> addedEdges;    // (父任务, 子任务)，每条为一个端口 0 的连接
+    std::vector<std::pair<int, int>> removedEdges;  // 删除两任务之间的全部端口连接
+    std::vector<std::pair<int, double>> changedCosts;
+};
+
+// 列表调度框架：按 rank 就绪队列逐个分配任务，每个任务放到得分（完成时间 + tileBias）最小的 TILE 上。
+// 任务在某个 TILE 上的就绪时间为各父任务的完成时间加上从父任务所在 TILE 传来的通信代价（见 CommModel），
+// rank 中的通信代价取其期望值。MeshTopology::contention 为 true 时，就绪时间改由 LinkSchedule 求出：评估各 TILE 时
+// 只查询链路上已预约的传输，选定 TILE 后按父任务完成时间依次预约该任务的入边传输，再以预约得到的到达时间放置任务。
+// HEFT 的 tileBias 为空；派生类可重写 calculateRanks 给出其他 rank 与 tileBias（见 PEFTPlanningAlgorithm）。
+class HEFTPlanningAlgorithm : public PlanningAlgorithm {
+protected:
+    struct TileChoice {
+        int tile = -1;          // TILE 下标
+        double ready = 0.0;     // 在该 TILE 上的就绪时间
+        double finish = 0.0;
+        double score = 0.0;     // 比较用：finish 加上该 TILE 的 tileBias
+    };
+
     std::vector<Task> tasks;
     std::vector<Tile> tiles;
+    std::shared_ptr<const CommModel> comm;
     std::vector<std::pair<int, double>> rankVector;
-    std::unordered_set<int> currentlyCalculating;
-    std::map<int, std::map<int, double>> computationCosts;
-    std::map<int, std::map<int, double>> transferCosts;
-    std::map<int, double> rank;
-    std::map<int, double> earliestFinishTimes;
+    TaskGraph dag;
+    std::vector<int> topoOrder;
+    std::vector<int> topoPosition;
+    std::vector<double> rank;
+    std::vector<double> tileBias;               // 空，或 tasks × tiles 行主序，选择 TILE 时加到完成时间上
+    std::vector<double> earliestFinishTimes;
+    std::vector<Event> taskEvents;              // 按 taskId 索引的分配结果
+    std::vector<int> taskTiles;                 // 按 taskId 索引的 TILE 下标
+    std::vector<int> allocationOrder;           // 就绪队列给出的分配顺序
     std::map<int, std::vector<Event>> schedules;
-    double epsilon = 1e-6;
-    double averageBandwidth;
-
-    double calculateAverageBandwidth();
+    std::vector<TileTimeline> timelines;        // 按 TILE 下标索引
+    bool contention = false;                    // 见 MeshTopology::contention
+    LinkSchedule links;
+    std::vector<std::pair<double, int>> transferOrder;   // bookTransfers 的暂存：(父任务完成时间, 父边)
+    WorkerPool* workerPool = nullptr;
+    std::vector<TileChoice> shardChoices;
+    // evaluateTiles 的暂存，按 dag.classTiles 中的位置索引；并行时各分片只写自己的区间
+    std::vector<double> tileReady;
+    std::vector<double> tileStarts;
+    std::vector<double> tileCosts;
+    std::vector<double> tileFinish;
+    std::vector<double> tileScore;
+    bool tileIdsAscending = true;               // 下标越大 tileId 越大时，得分相同取下标最小者即可
+    bool planned = false;
+    Arena scratch;                              // 单次规划内的临时数组，每次 run / replan 开始时整体回收
 
     bool isChildTask(const Task& taskA, const Task& taskB) ;   
 
-    static bool compareRank(const std::pair<int, double>& a, const std::pair<int, double>& b);
+    void buildTaskGraph(const std::vector<Task>& tasks, const std::vector<Tile>& tiles);
+
+    void buildTaskGraph(const DagFile& file);
+
+    void prepareTaskGraph();
 
-    void calculateComputationCosts(const std::vector<Task>& tasks, const std::vector<Tile>& tiles);
+    virtual void calculateRanks();
 
-    void calculateTransferCosts(const std::vector<Task>& tasks);
+    void computeTopologicalOrder();
 
-    double calculateTransferCost(const Task& parent, const Task& child);
+    void sortByRank();
 
-    void calculateRanks(const std::vector<Task>& tasks);
+    void computeAllocationOrder();
 
-    double calculateRank(const Task& task);
+    void collectSchedules();
+
+    std::vector<int> applyDelta(const TaskDelta& delta, std::vector<char>& rankSeeds, std::vector<char>& placementSeeds);
+
+    double averageComputationCost(int taskId) const;
     
-    bool checkTaskTileMatch(const Task& task, const Tile& tile);
 
-    void allocateTasks(const std::vector<Task>& tasks, const std::vector<Tile>& tiles);
+    void allocateTasks();
+
+    void allocateTask(int taskId);
+
+    TileChoice evaluateTiles(int taskId, int begin, int end);
 
-    bool compareTasks(const Task& a, const Task& b);
+    bool isBetterChoice(const TileChoice& candidate, const TileChoice& best) const;
 
-    void allocateTask(const Task& task);
+    // 链路竞争模式：预约任务放在 tileIndex 上时各父边的传输，返回其就绪时间
+    double bookTransfers(int taskId, int tileIndex);
 
-    double findFinishTime(const Task& task, const Tile& tile, double readyTime, bool occupySlot);  
+    double findFinishTime(int taskId, int tileIndex, double readyTime, bool occupySlot);  
 
 public:
-    HEFTPlanningAlgorithm(const std::vector<Task>& taskList, const std::vector<Tile>& tileList);
+    // comm 为空时按 TILE 数使用默认的 MeshTopology
+    HEFTPlanningAlgorithm(const std::vector<Task>& taskList, const std::vector<Tile>& tileList,
+                          std::shared_ptr<const CommModel> comm = nullptr);
+
+    const char* name() const override;
+
+    // 可选：用常驻线程池并行评估各 TILE 的 EFT，结果与串行完全一致
+    void setWorkerPool(WorkerPool* pool) override;
+
+    void run() override;
 
-    void run();
+    void run(const DagFile& file) override;
+
+    void reset(const std::vector<Task>& taskList) override;
+
+    // 增量重规划：应用 delta 后只为受影响任务及其祖先重算 rank，并只重新分配分配顺序中
+    // 第一个受影响位置之后的任务；结果与对变化后的任务集合调用 run() 完全一致。
+    // TaskGraph 与拓扑序仍整体重建，省下的只是分配顺序靠前部分的重新分配：变化集中在 DAG 末端时
+    // 约快 1.5 倍，变化位置随机时第一个受影响位置通常靠前，与 run() 基本持平（见 bench/replan_bench）。
+    // 返回重新分配的任务数。尚未 run() 过时等同于应用 delta 后 run()；run(DagFile) 之后不可用。
+    virtual int replan(const TaskDelta& delta);
 
     const std::vector<Task>& getTasks() const;
 
     const std::vector<Tile>& getTILEs() const;
 
-    const std::vector<std::pair<int, double>>& getRanks() const ;
+    const std::vector<std::pair<int, double>>& getRanks() const override;
 
     const std::map<int, std::vector<Event>>& getSchedules() const;
+
+    const std::vector<Event>& getTaskEvents() const override;
+
+    const TaskGraph& getTaskGraph() const;
+
+    // 所有任务的最晚完成时间（run 之后有效）
+    double getMakespan() const override;
+
+    // SLR：makespan 除以各任务取最小计算代价、不计通信时的关键路径长度
+    double getScheduleLengthRatio() const override;
 };
 
 #endif // HEFT_PLANNING_ALGORITHM_H
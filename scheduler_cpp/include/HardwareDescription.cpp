@@ -0,0 +1,233 @@
+#include "HardwareDescription.hpp"
+#include "Capability.hpp"
+#include <cmath>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+// 通信代价矩阵为 TILE 数的平方，限制规模以免描述耗尽内存。启动时读入的描述文件由部署方给出，上限较高；
+// 请求中的描述（服务与 Python 扩展）每个都可能不同，上限低得多
+const int kMaxTiles = 4096;
+const int kMaxRequestTiles = 256;
+
+// 请求描述缓存的内存上限（按 descriptionBytes 估计），超出时淘汰最久未用的条目
+const std::size_t kParsedCacheBytes = 16u << 20;
+
+Tile readTile(const json& entry, int tileId) {
+    Tile tile;
+    tile.tileId              = entry.value("tileId", tileId);
+    tile.computationCapacity = entry.at("computationCapacity").get<double>();
+    tile.spm_size            = entry.at("spm_size").get<int>();
+    tile.num_lane            = entry.at("num_lane").get<int>();
+    tile.has_bitalu          = entry.at("has_bitalu").get<bool>();
+    tile.has_serdiv          = entry.at("has_serdiv").get<bool>();
+    tile.has_complexunit     = entry.at("has_complexunit").get<bool>();
+    return tile;
+}
+
+MeshTopology readTopology(const json& noc) {
+    MeshTopology mesh;
+    mesh.columns          = noc.value("columns", mesh.columns);
+    mesh.linkBandwidth    = noc.value("linkBandwidth", mesh.linkBandwidth);
+    mesh.hopLatency       = noc.value("hopLatency", mesh.hopLatency);
+    mesh.transferOverhead = noc.value("transferOverhead", mesh.transferOverhead);
+    mesh.contention       = noc.value("contention", mesh.contention);
+    return mesh;
+}
+
+struct DescriptionText {
+    std::vector<Tile> tiles;
+    MeshTopology mesh;
+};
+
+DescriptionText readDescription(std::string_view text, int maxTiles) {
+    DescriptionText result;
+    std::vector<Tile>& tiles = result.tiles;
+    try {
+        json document = json::parse(text.begin(), text.end());
+        if (document.is_object()) {
+            result.mesh = readTopology(document.value("noc", json::object()));
+        }
+        const json& tileData = document.is_object() ? document.at("tiles") : document;
+        if (!tileData.is_array()) {
+            throw std::invalid_argument("hardware description must be a tile array or an object with \"tiles\"");
+        }
+        int nextId = 0;
+        for (const auto& entry : tileData) {
+            int count = entry.value("count", 1);
+            if (count < 1 || count > maxTiles - static_cast<int>(tiles.size())) {
+                throw std::invalid_argument("tile count must be between 1 and " + std::to_string(maxTiles) +
+                                            " in total");
+            }
+            Tile tile = readTile(entry, nextId);
+            for (int k = 0; k < count; ++k) {
+                tiles.push_back(tile);
+                ++tile.tileId;
+            }
+            nextId = tile.tileId;
+        }
+    } catch (const json::exception& e) {
+        throw std::invalid_argument(e.what());
+    }
+    return result;
+}
+
+template <typename T>
+void appendBytes(std::string& key, const T& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// 缓存键：解析后的各字段逐个按字节拼接，空白、键顺序与 count 写法不同的同一描述得到同一个键
+std::string normalizedKey(const DescriptionText& description) {
+    std::string key;
+    key.reserve(description.tiles.size() * 32 + 40);
+    const MeshTopology& mesh = description.mesh;
+    appendBytes(key, mesh.columns);
+    appendBytes(key, mesh.linkBandwidth);
+    appendBytes(key, mesh.hopLatency);
+    appendBytes(key, mesh.transferOverhead);
+    appendBytes(key, mesh.contention);
+    for (const Tile& tile : description.tiles) {
+        appendBytes(key, tile.tileId);
+        appendBytes(key, tile.computationCapacity);
+        appendBytes(key, tile.spm_size);
+        appendBytes(key, tile.num_lane);
+        appendBytes(key, tile.has_bitalu);
+        appendBytes(key, tile.has_serdiv);
+        appendBytes(key, tile.has_complexunit);
+    }
+    return key;
+}
+
+// 描述占用的内存：TILE 数组加上 CommModel 的两个 T × T 矩阵
+std::size_t descriptionBytes(const HardwareDescription& description) {
+    std::size_t tileCount = description.tiles().size();
+    return tileCount * sizeof(Tile) + 2 * tileCount * tileCount * sizeof(double);
+}
+
+// 请求描述的进程内缓存，线程安全，按字节数 LRU 淘汰
+class DescriptionCache {
+public:
+    std::shared_ptr<const HardwareDescription> find(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        recent.splice(recent.begin(), recent, it->second);
+        return it->second->description;
+    }
+
+    // 已有同键条目时返回已登记的对象（并发解析同一描述时先登记者胜出）
+    std::shared_ptr<const HardwareDescription> insert(const std::string& key,
+                                                      std::shared_ptr<const HardwareDescription> description) {
+        std::size_t size = key.size() + descriptionBytes(*description);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            recent.splice(recent.begin(), recent, it->second);
+            return it->second->description;
+        }
+        if (size > kParsedCacheBytes) {
+            return description;
+        }
+        recent.push_front(Entry{key, description, size});
+        index[key] = recent.begin();
+        bytes += size;
+        while (bytes > kParsedCacheBytes) {
+            bytes -= recent.back().bytes;
+            index.erase(recent.back().key);
+            recent.pop_back();
+        }
+        return description;
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const HardwareDescription> description;
+        std::size_t bytes;
+    };
+
+    std::mutex mutex;
+    std::list<Entry> recent;            // 表头为最近使用
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::size_t bytes = 0;
+};
+
+}
+
+HardwareDescription::HardwareDescription(std::vector<Tile> tiles, const MeshTopology& topology)
+    : tileList(std::move(tiles)) {
+    if (tileList.empty()) {
+        throw std::invalid_argument("hardware description has no tiles");
+    }
+    if (tileList.size() > static_cast<std::size_t>(kMaxTiles)) {
+        throw std::invalid_argument("hardware description has more than " + std::to_string(kMaxTiles) + " tiles");
+    }
+    std::unordered_set<int> tileIds;
+    for (const auto& tile : tileList) {
+        std::string where = "tile " + std::to_string(tile.tileId);
+        if (!tileIds.insert(tile.tileId).second) {
+            throw std::invalid_argument("duplicate " + where);
+        }
+        if (!(tile.computationCapacity > 0.0) || !std::isfinite(tile.computationCapacity)) {
+            throw std::invalid_argument(where + ": computationCapacity must be positive");
+        }
+        if (!capabilityInRange(tile.spm_size, tile.num_lane)) {
+            throw std::invalid_argument(where + ": spm_size/num_lane out of range");
+        }
+    }
+    commModel = std::make_shared<const CommModel>(tileList, topology);
+}
+
+std::shared_ptr<const HardwareDescription> HardwareDescription::parse(std::string_view text) {
+    static DescriptionCache cache;
+    DescriptionText description = readDescription(text, kMaxRequestTiles);
+    std::string key = normalizedKey(description);
+    std::shared_ptr<const HardwareDescription> cached = cache.find(key);
+    if (cached) {
+        return cached;
+    }
+    // 构造（含通信代价矩阵）在锁外进行
+    return cache.insert(key, std::make_shared<const HardwareDescription>(std::move(description.tiles),
+                                                                         description.mesh));
+}
+
+std::shared_ptr<const HardwareDescription> HardwareDescription::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("cannot open hardware description: " + filename);
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    DescriptionText description = readDescription(text.str(), kMaxTiles);
+    return std::make_shared<const HardwareDescription>(std::move(description.tiles), description.mesh);
+}
+
+std::shared_ptr<const HardwareDescription> HardwareDescription::builtin() {
+    static const std::shared_ptr<const HardwareDescription> description =
+        uniform(3, Tile{0, 1, 1, 1, false, false, false});
+    return description;
+}
+
+std::shared_ptr<const HardwareDescription> HardwareDescription::uniform(int tileCount, const Tile& prototype,
+                                                                        const MeshTopology& topology) {
+    if (tileCount < 1) {
+        throw std::invalid_argument("tile count must be positive");
+    }
+    std::vector<Tile> tiles(tileCount, prototype);
+    for (int p = 0; p < tileCount; ++p) {
+        tiles[p].tileId = p;
+    }
+    return std::make_shared<const HardwareDescription>(std::move(tiles), topology);
+}
@@ -0,0 +1,56 @@
+#ifndef HARDWAREDESCRIPTION_H
+#define HARDWAREDESCRIPTION_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CommModel.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+
+// 规划用的硬件描述：TILE 集合（能力字段、算力、SPM）与片上网络拓扑。构造时校验，之后不可变，
+// 以 shared_ptr<const HardwareDescription> 在单文件、批处理、服务与 Python 扩展的各规划器之间共享；
+// 通信代价模型随描述一起只构造一次。
+//
+// 描述文件（JSON）：TILE 数组，或 {"tiles": [...], "noc": {...}}。
+//   TILE 的字段与 Tile 同名（computationCapacity, spm_size, num_lane, has_bitalu, has_serdiv, has_complexunit）；
+//   tileId 可省略，缺省为上一个 TILE 的 tileId + 1（第一个为 0）；"count": n 表示 n 个相同的 TILE，tileId 依次递增。
+//   noc 的字段与 MeshTopology 同名且均可省略。
+// 例如 64 个相同 TILE 的 8 × 8 mesh：{"tiles": [{"count": 64, "computationCapacity": 1, "spm_size": 1, ...}],
+//                                     "noc": {"columns": 8}}
+class HardwareDescription {
+public:
+    // TILE 为空、tileId 重复、算力不为正、能力字段越界或拓扑参数非法时抛出 std::invalid_argument
+    HardwareDescription(std::vector<Tile> tiles, const MeshTopology& topology);
+
+    const std::vector<Tile>& tiles() const { return tileList; }
+
+    int tileCount() const { return static_cast<int>(tileList.size()); }
+
+    // columns 已按 TILE 数确定
+    const MeshTopology& topology() const { return commModel->topology(); }
+
+    const std::shared_ptr<const CommModel>& comm() const { return commModel; }
+
+    // 解析请求中的描述文本（服务与 Python 扩展），至多 256 个 TILE。按解析后的 TILE 与拓扑缓存（进程内、线程安全，
+    // 按内存字节数 LRU 淘汰），写法不同的同一描述返回同一个对象。
+    // JSON 非法、字段缺失或类型错误以及校验失败时抛出 std::invalid_argument
+    static std::shared_ptr<const HardwareDescription> parse(std::string_view text);
+
+    // 读取启动时给出的描述文件（main --hardware），至多 4096 个 TILE，不进入 parse 的缓存。
+    // 文件不可读时抛出 std::runtime_error，其余错误同 parse
+    static std::shared_ptr<const HardwareDescription> load(const std::string& filename);
+
+    // 未给出描述时使用的内置配置：三个相同的 TILE
+    static std::shared_ptr<const HardwareDescription> builtin();
+
+    // tileCount 个与 prototype 相同的 TILE，tileId 为 0 .. tileCount - 1
+    static std::shared_ptr<const HardwareDescription> uniform(int tileCount, const Tile& prototype,
+                                                              const MeshTopology& topology = MeshTopology());
+
+private:
+    std::vector<Tile> tileList;
+    std::shared_ptr<const CommModel> commModel;
+};
+
+#endif // HARDWAREDESCRIPTION_H
@@ -1,11 +0,0 @@
-#ifndef INPUTTILE_H
-#define INPUTTILE_H
-
-#include "HEFTPlanningAlgorithm.hpp"
-
-class InputTile {
-public:
-    static std::vector<Tile> setupTiles();
-};
-
-#endif // INPUTTILE_H
\ No newline at end of file
@@ -1,10 +1,15 @@
 #include "JsonParser.hpp"
+#include "Trace.hpp"
+#include <cstdlib>
 #include <fstream>
+#include <stdexcept>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
-std::vector<inputTask> JsonParser::parseJson(const std::string& filename) {
+std::vector<inputTask> JsonParser::parseJson(const std::string& filename, StringPool& pool) {
+    PhaseTimer timer(TracePhase::Parse);
     std::ifstream file(filename);
     json jsonData;
     file >> jsonData;
@@ -13,7 +18,7 @@ std::vector<inputTask> JsonParser::parseJson(const std::string& filename) {
 
     for (const auto& taskData : jsonData) {
         inputTask task;
-        task.taskId          = taskData["taskId"];
+        task.taskId          = pool.intern(taskData["taskId"].get<std::string>());
         task.computationCost = taskData["computationCost"];
         task.spm_size        = taskData["spm_size"];
         task.num_lane        = taskData["num_lane"];
@@ -26,39 +31,35 @@ std::vector<inputTask> JsonParser::parseJson(const std::string& filename) {
         task.text_length     = taskData["text_length"];
         task.data_length     = taskData["data_length"];
         task.output_num      = taskData["output_num"];
-        task.hardwareinfo    = taskData["hardwareinfo"];
-        task.hash            = taskData["hash"];
+        task.hardwareinfo    = pool.intern(taskData["hardwareinfo"].get<std::string>());
+        task.hash            = pool.intern(taskData["hash"].get<std::string>());
 
         // parent
         for (const auto& parentTask : taskData["parentTasks"]) {
             std::string parentId = parentTask["taskId"];
             int outputPort = parentTask["outputIndex"];
-            std::cout << "parentTask_dest: " << parentTask["dest_address"] << std::endl;
             int concat_value = parentTask["concat_value"];
             std::string parentTask_slice_length   ;
             std::string parentTask_slice_data_type;
             std::string varname = parentTask["outputVar"];
 
-            if (parentTask["dest_address"] != "null"){   
-                std::cout << "if parentTask_dest: " << parentTask["dest_address"] << std::endl;
-                std::string dest_addr = parentTask["dest_address"];
-                if (parentTask.find("slice_length") != parentTask.end()) {
-                    parentTask_slice_length = parentTask["slice_length"];
-                    parentTask_slice_data_type = parentTask["slice_data_type"];
-                }
-                else {
-                    parentTask_slice_length = "0";
-                    parentTask_slice_data_type = "0";
-                }
-                task.parentTasks.push_back({parentId, outputPort, dest_addr, concat_value, parentTask_slice_length, parentTask_slice_data_type, varname});
+            // dest_address 为 "null" 的父任务边只用于调度，不输出
+            std::string dest_addr = parentTask["dest_address"];
+            if (parentTask.find("slice_length") != parentTask.end()) {
+                parentTask_slice_length = parentTask["slice_length"];
+                parentTask_slice_data_type = parentTask["slice_data_type"];
             }
+            else {
+                parentTask_slice_length = "0";
+                parentTask_slice_data_type = "0";
+            }
+            task.parentTasks.push_back({pool.intern(parentId), outputPort, EdgePort::parse(pool, dest_addr, parentTask_slice_length, parentTask_slice_data_type), concat_value, pool.intern(varname)});
         }
 
         // child
         for (const auto& childTask : taskData["childTasks"]) {
             std::string childId = childTask["taskId"];
             int inputPort = childTask["inputIndex"];
-            std::string dest_addr = "null";
             int concat_value = childTask["concat_value"];
             std::string childTask_slice_length ;
             std::string childTask_slice_data_type;
@@ -72,17 +73,16 @@ std::vector<inputTask> JsonParser::parseJson(const std::string& filename) {
                 childTask_slice_length    = "0";
                 childTask_slice_data_type = "0";
             }
-            task.childTasks.push_back({childId, inputPort, dest_addr, concat_value, childTask_slice_length, childTask_slice_data_type, varname});
+            task.childTasks.push_back({pool.intern(childId), inputPort, EdgePort::unaddressed(pool, childTask_slice_length, childTask_slice_data_type), concat_value, pool.intern(varname)});
         }
 
         //data
         for (const auto& global_Input : taskData["global_Input"]) {
             std::string globalId = global_Input["name"];
-            std::cout << "global_Input: " << global_Input["dest_address"] << std::endl;
             if (global_Input["dest_address"] != "null")
-            {   std::cout << "in global_Input: " << global_Input["dest_address"] << std::endl;
+            {
                 std::string global_addr = global_Input["dest_address"];
-                task.global_Input.push_back({globalId, global_addr});
+                task.global_Input.push_back({pool.intern(globalId), pool.intern(global_addr)});
             }
         }
         for (const auto& para_Input : taskData["para_Input"]) {
@@ -99,13 +99,13 @@ std::vector<inputTask> JsonParser::parseJson(const std::string& filename) {
                     para_slice_length = "0";
                     para_slice_data_type = "0";
                 }
-                task.para_Input.push_back({paraId, paraId_addr, para_slice_length, para_slice_data_type});
+                task.para_Input.push_back({pool.intern(paraId), EdgePort::parse(pool, paraId_addr, para_slice_length, para_slice_data_type)});
             }
         }
         for (const auto& return_output : taskData["return_output"]) {
             std::string returnId = return_output["name"];
             int return_port = return_output["index"];
-            task.return_output.push_back({returnId, return_port});
+            task.return_output.push_back({pool.intern(returnId), return_port});
         }
 
 
@@ -114,3 +114,651 @@ std::vector<inputTask> JsonParser::parseJson(const std::string& filename) {
 
     return inputTasks;
 }
+
+namespace {
+
+enum class TaskField {
+    Unknown, TaskId, ComputationCost, SpmSize, NumLane, HasBitalu, HasSerdiv, HasComplexunit,
+    TextOffset, DataOffset, TotalLength, TextLength, DataLength, OutputNum, Hardwareinfo, Hash,
+    ParentTasks, ChildTasks, GlobalInput, ParaInput, ReturnOutput
+};
+
+enum class ItemField {
+    Unknown, TaskId, Index, Var, ConcatValue, DestAddress, SliceLength, SliceDataType, Name
+};
+
+struct Scalar {
+    enum Kind { Null, Boolean, Integer, Float, String } kind = Null;
+    bool boolean = false;
+    long long integer = 0;
+    double number = 0.0;
+    std::string text;
+};
+
+// parentTasks / childTasks / global_Input / para_Input / return_output 中的一项
+struct ListItem {
+    Symbol taskId = 0;
+    int index = 0;
+    Symbol var = 0;
+    int concatValue = 0;
+    bool hasDest = false;
+    Symbol destAddress = 0;
+    bool hasSlice = false;
+    Symbol sliceLength = 0;
+    Symbol sliceDataType = 0;
+    Symbol name = 0;
+
+    void reset() {
+        *this = ListItem();
+    }
+};
+
+// 逐个 SAX 事件直接构造 inputTask，不建立 DOM。
+// depth：1 = 顶层数组，2 = 任务对象，3 = 任务中的列表字段，4 = 列表项对象。
+// 字段语义与 parseJson 一致（dest_address 为 "null" 的父任务边只用于调度，其余输入被丢弃；缺省的 slice 字段记为 "0"）；
+// 数值字段同时接受数字和数字字符串（如 "0x0"），布尔字段同时接受 true/false 与 0/1。
+class TaskSaxHandler {
+public:
+    using json = nlohmann::json;
+
+    TaskSaxHandler(std::vector<inputTask>& tasks, StringPool& pool)
+        : tasks(tasks), pool(pool), nullText(pool.intern("null")), zeroText(pool.intern("0")) {}
+
+    const std::string& error() const { return errorMessage; }
+
+    bool null() {
+        value.kind = Scalar::Null;
+        return scalar();
+    }
+
+    bool boolean(bool v) {
+        value.kind = Scalar::Boolean;
+        value.boolean = v;
+        return scalar();
+    }
+
+    bool number_integer(json::number_integer_t v) {
+        value.kind = Scalar::Integer;
+        value.integer = v;
+        return scalar();
+    }
+
+    bool number_unsigned(json::number_unsigned_t v) {
+        value.kind = Scalar::Integer;
+        value.integer = static_cast<long long>(v);
+        return scalar();
+    }
+
+    bool number_float(json::number_float_t v, const json::string_t&) {
+        value.kind = Scalar::Float;
+        value.number = v;
+        return scalar();
+    }
+
+    bool string(json::string_t& v) {
+        value.kind = Scalar::String;
+        value.text.swap(v);
+        return scalar();
+    }
+
+    bool binary(json::binary_t&) {
+        return fail("binary values are not supported");
+    }
+
+    bool start_object(std::size_t) {
+        ++depth;
+        if (skipDepth != 0) {
+            return true;
+        }
+        if (depth == 2) {
+            current = inputTask();
+            return true;
+        }
+        if (depth == 4 && list != TaskField::Unknown) {
+            item.reset();
+            return true;
+        }
+        if (depth == 1) {
+            return fail("top-level value must be an array of tasks");
+        }
+        skipDepth = depth;
+        return true;
+    }
+
+    bool end_object() {
+        if (skipDepth == depth) {
+            skipDepth = 0;
+        } else if (skipDepth == 0) {
+            if (depth == 2) {
+                tasks.push_back(std::move(current));
+            } else if (depth == 4 && !commitItem()) {
+                return false;
+            }
+        }
+        --depth;
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        ++depth;
+        if (skipDepth != 0 || depth == 1) {
+            return true;
+        }
+        if (depth == 3 && isListField(field)) {
+            list = field;
+            return true;
+        }
+        skipDepth = depth;
+        return true;
+    }
+
+    bool end_array() {
+        if (skipDepth == depth) {
+            skipDepth = 0;
+        } else if (skipDepth == 0 && depth == 3) {
+            list = TaskField::Unknown;
+        }
+        --depth;
+        return true;
+    }
+
+    bool key(json::string_t& name) {
+        if (skipDepth != 0) {
+            return true;
+        }
+        if (depth == 2) {
+            field = taskField(name);
+        } else if (depth == 4) {
+            itemField = listItemField(name);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+        return fail(ex.what());
+    }
+
+private:
+    std::vector<inputTask>& tasks;
+    StringPool& pool;
+    const Symbol nullText;
+    const Symbol zeroText;
+    inputTask current;
+    ListItem item;
+    Scalar value;
+    TaskField field = TaskField::Unknown;
+    TaskField list = TaskField::Unknown;
+    ItemField itemField = ItemField::Unknown;
+    int depth = 0;
+    int skipDepth = 0;
+    std::string errorMessage;
+
+    static TaskField taskField(const std::string& name) {
+        static const std::unordered_map<std::string, TaskField> fields = {
+            {"taskId", TaskField::TaskId},
+            {"computationCost", TaskField::ComputationCost},
+            {"spm_size", TaskField::SpmSize},
+            {"num_lane", TaskField::NumLane},
+            {"has_bitalu", TaskField::HasBitalu},
+            {"has_serdiv", TaskField::HasSerdiv},
+            {"has_complexunit", TaskField::HasComplexunit},
+            {"text_offset", TaskField::TextOffset},
+            {"data_offset", TaskField::DataOffset},
+            {"total_length", TaskField::TotalLength},
+            {"text_length", TaskField::TextLength},
+            {"data_length", TaskField::DataLength},
+            {"output_num", TaskField::OutputNum},
+            {"hardwareinfo", TaskField::Hardwareinfo},
+            {"hash", TaskField::Hash},
+            {"parentTasks", TaskField::ParentTasks},
+            {"childTasks", TaskField::ChildTasks},
+            {"global_Input", TaskField::GlobalInput},
+            {"para_Input", TaskField::ParaInput},
+            {"return_output", TaskField::ReturnOutput},
+        };
+        auto it = fields.find(name);
+        return it == fields.end() ? TaskField::Unknown : it->second;
+    }
+
+    static ItemField listItemField(const std::string& name) {
+        static const std::unordered_map<std::string, ItemField> fields = {
+            {"taskId", ItemField::TaskId},
+            {"outputIndex", ItemField::Index},
+            {"inputIndex", ItemField::Index},
+            {"index", ItemField::Index},
+            {"outputVar", ItemField::Var},
+            {"inputVar", ItemField::Var},
+            {"concat_value", ItemField::ConcatValue},
+            {"dest_address", ItemField::DestAddress},
+            {"slice_length", ItemField::SliceLength},
+            {"slice_data_type", ItemField::SliceDataType},
+            {"name", ItemField::Name},
+        };
+        auto it = fields.find(name);
+        return it == fields.end() ? ItemField::Unknown : it->second;
+    }
+
+    static bool isListField(TaskField f) {
+        return f == TaskField::ParentTasks || f == TaskField::ChildTasks || f == TaskField::GlobalInput ||
+               f == TaskField::ParaInput || f == TaskField::ReturnOutput;
+    }
+
+    bool fail(const std::string& message) {
+        if (errorMessage.empty()) {
+            errorMessage = message;
+        }
+        return false;
+    }
+
+    bool toNumber(double& out) {
+        switch (value.kind) {
+        case Scalar::Integer:
+            out = static_cast<double>(value.integer);
+            return true;
+        case Scalar::Float:
+            out = value.number;
+            return true;
+        case Scalar::Boolean:
+            out = value.boolean ? 1.0 : 0.0;
+            return true;
+        case Scalar::String: {
+            char* end = nullptr;
+            out = std::strtod(value.text.c_str(), &end);
+            return !value.text.empty() && *end == '\0';
+        }
+        default:
+            return false;
+        }
+    }
+
+    bool toInt(int& out) {
+        if (value.kind == Scalar::String) {
+            char* end = nullptr;
+            long long parsed = std::strtoll(value.text.c_str(), &end, 0);
+            out = static_cast<int>(parsed);
+            return !value.text.empty() && *end == '\0';
+        }
+        if (value.kind == Scalar::Integer) {
+            out = static_cast<int>(value.integer);
+            return true;
+        }
+        double number;
+        if (!toNumber(number)) {
+            return false;
+        }
+        out = static_cast<int>(number);
+        return true;
+    }
+
+    bool toBool(bool& out) {
+        if (value.kind == Scalar::Boolean) {
+            out = value.boolean;
+            return true;
+        }
+        int number;
+        if (!toInt(number)) {
+            return false;
+        }
+        out = number != 0;
+        return true;
+    }
+
+    bool toText(std::string& out) {
+        switch (value.kind) {
+        case Scalar::String:
+            out.swap(value.text);
+            return true;
+        case Scalar::Integer:
+            out = std::to_string(value.integer);
+            return true;
+        case Scalar::Null:
+            out = "null";
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool toSymbol(Symbol& out) {
+        if (value.kind == Scalar::String) {
+            out = pool.intern(value.text);
+            return true;
+        }
+        std::string text;
+        if (!toText(text)) {
+            return false;
+        }
+        out = pool.intern(text);
+        return true;
+    }
+
+    bool typeError(const char* name) {
+        return fail(std::string("unexpected value type for \"") + name + "\" in task \"" + std::string(pool.view(current.taskId)) + "\"");
+    }
+
+    bool scalar() {
+        if (skipDepth != 0) {
+            return true;
+        }
+        if (depth == 2) {
+            return taskScalar();
+        }
+        if (depth == 4) {
+            return itemScalar();
+        }
+        return fail("unexpected scalar value outside of a task object");
+    }
+
+    bool taskScalar() {
+        switch (field) {
+        case TaskField::TaskId:          return toSymbol(current.taskId) || typeError("taskId");
+        case TaskField::ComputationCost: return toNumber(current.computationCost) || typeError("computationCost");
+        case TaskField::SpmSize:         return toInt(current.spm_size) || typeError("spm_size");
+        case TaskField::NumLane:         return toInt(current.num_lane) || typeError("num_lane");
+        case TaskField::HasBitalu:       return toBool(current.has_bitalu) || typeError("has_bitalu");
+        case TaskField::HasSerdiv:       return toBool(current.has_serdiv) || typeError("has_serdiv");
+        case TaskField::HasComplexunit:  return toBool(current.has_complexunit) || typeError("has_complexunit");
+        case TaskField::TextOffset:      return toInt(current.text_offset) || typeError("text_offset");
+        case TaskField::DataOffset:      return toInt(current.data_offset) || typeError("data_offset");
+        case TaskField::TotalLength:     return toInt(current.total_length) || typeError("total_length");
+        case TaskField::TextLength:      return toInt(current.text_length) || typeError("text_length");
+        case TaskField::DataLength:      return toInt(current.data_length) || typeError("data_length");
+        case TaskField::OutputNum:       return toInt(current.output_num) || typeError("output_num");
+        case TaskField::Hardwareinfo:    return toSymbol(current.hardwareinfo) || typeError("hardwareinfo");
+        case TaskField::Hash:            return toSymbol(current.hash) || typeError("hash");
+        default:                         return true;
+        }
+    }
+
+    bool itemScalar() {
+        switch (itemField) {
+        case ItemField::TaskId:        return toSymbol(item.taskId) || typeError("taskId");
+        case ItemField::Index:         return toInt(item.index) || typeError("index");
+        case ItemField::Var:           return toSymbol(item.var) || typeError("var");
+        case ItemField::ConcatValue:   return toInt(item.concatValue) || typeError("concat_value");
+        case ItemField::Name:          return toSymbol(item.name) || typeError("name");
+        case ItemField::DestAddress:
+            item.hasDest = true;
+            return toSymbol(item.destAddress) || typeError("dest_address");
+        case ItemField::SliceLength:
+            item.hasSlice = true;
+            return toSymbol(item.sliceLength) || typeError("slice_length");
+        case ItemField::SliceDataType:
+            return toSymbol(item.sliceDataType) || typeError("slice_data_type");
+        default:
+            return true;
+        }
+    }
+
+    EdgePort itemPort(bool hasAddress) {
+        std::string_view sliceLength = pool.view(item.sliceLength);
+        std::string_view sliceDataType = pool.view(item.sliceDataType);
+        if (!hasAddress) {
+            return EdgePort::unaddressed(pool, sliceLength, sliceDataType);
+        }
+        return EdgePort::parse(pool, pool.view(item.destAddress), sliceLength, sliceDataType);
+    }
+
+    // 父任务边不论有无地址都校验切片字段（字节数用于通信代价）
+    EdgePort parentPort(bool hasAddress) {
+        return EdgePort::parse(pool, pool.view(hasAddress ? item.destAddress : nullText), pool.view(item.sliceLength),
+                               pool.view(item.sliceDataType));
+    }
+
+    bool commitItem() {
+        if (!item.hasSlice) {
+            item.sliceLength = zeroText;
+            item.sliceDataType = zeroText;
+        }
+        bool hasAddress = item.hasDest && item.destAddress != nullText;
+        try {
+            switch (list) {
+            case TaskField::ParentTasks:
+                current.parentTasks.push_back({item.taskId, item.index, parentPort(hasAddress), item.concatValue,
+                                               item.var});
+                break;
+            case TaskField::ChildTasks:
+                current.childTasks.push_back({item.taskId, item.index, itemPort(false), item.concatValue, item.var});
+                break;
+            case TaskField::GlobalInput:
+                if (hasAddress) {
+                    current.global_Input.push_back({item.name, item.destAddress});
+                }
+                break;
+            case TaskField::ParaInput:
+                if (hasAddress) {
+                    current.para_Input.push_back({item.name, itemPort(true)});
+                }
+                break;
+            case TaskField::ReturnOutput:
+                current.return_output.push_back({item.name, item.index});
+                break;
+            default:
+                break;
+            }
+        } catch (const std::invalid_argument& e) {
+            return fail(std::string(e.what()) + " in task \"" + std::string(pool.view(current.taskId)) + "\"");
+        }
+        return true;
+    }
+};
+
+// 服务模式的请求体：任务数组本身，或 {"planner": "...", "hardware": {...}, "tasks": [...]} / {"command": "..."}。
+// "tasks" 内的事件原样转发给 TaskSaxHandler；"hardware" 的值（对象或数组）按事件重建后序列化为文本，
+// 交给 HardwareDescription 解析；其余顶层字段只接受字符串，未知字段报错。
+class RequestSaxHandler {
+public:
+    using json = nlohmann::json;
+
+    RequestSaxHandler(std::vector<inputTask>& tasks, StringPool& pool, RequestOptions& options)
+        : taskHandler(tasks, pool), options(options) {}
+
+    const std::string& error() const { return errorMessage.empty() ? taskHandler.error() : errorMessage; }
+
+    bool null() { return forwarding() ? taskHandler.null() : inHardware ? hardwareValue(nullptr) : unexpected(); }
+    bool boolean(bool v) { return forwarding() ? taskHandler.boolean(v) : inHardware ? hardwareValue(v) : unexpected(); }
+    bool number_integer(json::number_integer_t v) {
+        return forwarding() ? taskHandler.number_integer(v) : inHardware ? hardwareValue(v) : unexpected();
+    }
+    bool number_unsigned(json::number_unsigned_t v) {
+        return forwarding() ? taskHandler.number_unsigned(v) : inHardware ? hardwareValue(v) : unexpected();
+    }
+    bool number_float(json::number_float_t v, const json::string_t& s) {
+        return forwarding() ? taskHandler.number_float(v, s) : inHardware ? hardwareValue(v) : unexpected();
+    }
+    bool binary(json::binary_t& v) { return forwarding() ? taskHandler.binary(v) : unexpected(); }
+
+    bool string(json::string_t& v) {
+        if (forwarding()) {
+            return taskHandler.string(v);
+        }
+        if (inHardware) {
+            return hardwareValue(std::move(v));
+        }
+        if (target == nullptr) {
+            return unexpected();
+        }
+        target->swap(v);
+        target = nullptr;
+        return true;
+    }
+
+    bool start_object(std::size_t size) {
+        if (forwarding()) {
+            ++taskDepth;
+            return taskHandler.start_object(size);
+        }
+        if (inHardware) {
+            return hardwareOpen(json::object());
+        }
+        if (envelope) {
+            return unexpected();
+        }
+        envelope = true;
+        return true;
+    }
+
+    bool end_object() {
+        if (forwarding()) {
+            --taskDepth;
+            return taskHandler.end_object();
+        }
+        return inHardware ? hardwareClose() : true;
+    }
+
+    bool start_array(std::size_t size) {
+        if (inHardware) {
+            return hardwareOpen(json::array());
+        }
+        if (!forwarding() && envelope != inTasks) {
+            return unexpected();
+        }
+        ++taskDepth;
+        return taskHandler.start_array(size);
+    }
+
+    bool end_array() {
+        if (inHardware) {
+            return hardwareClose();
+        }
+        --taskDepth;
+        if (taskDepth == 0) {
+            inTasks = false;
+        }
+        return taskHandler.end_array();
+    }
+
+    bool key(json::string_t& name) {
+        if (forwarding()) {
+            return taskHandler.key(name);
+        }
+        if (inHardware) {
+            hardwareKey.swap(name);
+            return true;
+        }
+        target = nullptr;
+        if (name == "tasks") {
+            inTasks = true;
+        } else if (name == "hardware") {
+            inHardware = true;
+        } else if (name == "planner") {
+            target = &options.planner;
+        } else if (name == "command") {
+            target = &options.command;
+        } else {
+            return fail("unknown request field \"" + name + "\"");
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string& token, const nlohmann::detail::exception& ex) {
+        return taskHandler.parse_error(position, token, ex);
+    }
+
+private:
+    TaskSaxHandler taskHandler;
+    RequestOptions& options;
+    std::string* target = nullptr;
+    bool envelope = false;
+    bool inTasks = false;
+    int taskDepth = 0;
+    bool inHardware = false;
+    json hardwareDocument;
+    std::vector<json*> hardwareStack;   // 正在填充的容器，均为 hardwareDocument 内的结点
+    std::string hardwareKey;
+    std::string errorMessage;
+
+    bool forwarding() const { return taskDepth > 0; }
+
+    bool hardwareValue(json value) {
+        if (hardwareStack.empty()) {
+            return fail("request field \"hardware\" must be an object or an array");
+        }
+        json& parent = *hardwareStack.back();
+        if (parent.is_object()) {
+            parent[hardwareKey] = std::move(value);
+        } else {
+            parent.push_back(std::move(value));
+        }
+        return true;
+    }
+
+    bool hardwareOpen(json container) {
+        if (hardwareStack.empty()) {
+            hardwareDocument = std::move(container);
+            hardwareStack.push_back(&hardwareDocument);
+            return true;
+        }
+        json& parent = *hardwareStack.back();
+        if (parent.is_object()) {
+            hardwareStack.push_back(&(parent[hardwareKey] = std::move(container)));
+        } else {
+            parent.push_back(std::move(container));
+            hardwareStack.push_back(&parent.back());
+        }
+        return true;
+    }
+
+    bool hardwareClose() {
+        hardwareStack.pop_back();
+        if (hardwareStack.empty()) {
+            options.hardware = hardwareDocument.dump();
+            hardwareDocument = nullptr;
+            inHardware = false;
+        }
+        return true;
+    }
+
+    bool unexpected() {
+        return fail("request must be an array of tasks or an object with \"tasks\", \"planner\", \"hardware\" "
+                    "or \"command\"");
+    }
+
+    bool fail(const std::string& message) {
+        if (errorMessage.empty()) {
+            errorMessage = message;
+        }
+        return false;
+    }
+};
+
+}
+
+std::vector<inputTask> JsonParser::parseJsonStream(const std::string& filename, StringPool& pool) {
+    PhaseTimer timer(TracePhase::Parse);
+    // 缓冲区需在 open 之前设置才会生效
+    std::vector<char> buffer(1 << 20);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("cannot open input file: " + filename);
+    }
+
+    std::vector<inputTask> inputTasks;
+    TaskSaxHandler handler(inputTasks, pool);
+    if (!json::sax_parse(file, &handler)) {
+        throw std::runtime_error(handler.error());
+    }
+    return inputTasks;
+}
+
+std::vector<inputTask> JsonParser::parseJsonBuffer(std::string_view text, StringPool& pool) {
+    PhaseTimer timer(TracePhase::Parse);
+    std::vector<inputTask> inputTasks;
+    TaskSaxHandler handler(inputTasks, pool);
+    if (!json::sax_parse(text.begin(), text.end(), &handler)) {
+        throw std::runtime_error(handler.error());
+    }
+    return inputTasks;
+}
+
+std::vector<inputTask> JsonParser::parseRequestBuffer(std::string_view text, StringPool& pool, RequestOptions& options) {
+    PhaseTimer timer(TracePhase::Parse);
+    std::vector<inputTask> inputTasks;
+    RequestSaxHandler handler(inputTasks, pool, options);
+    if (!json::sax_parse(text.begin(), text.end(), &handler)) {
+        throw std::runtime_error(handler.error());
+    }
+    return inputTasks;
+}
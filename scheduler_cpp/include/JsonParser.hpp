@@ -2,12 +2,29 @@
 #define JSONPARSER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "HEFTPlanningAlgorithm.hpp"
 
+// 服务模式请求体中的顶层选项（见 parseRequestBuffer），未给出时为空
+struct RequestOptions {
+    std::string planner;
+    std::string command;
+    std::string hardware;   // 硬件描述的 JSON 文本（见 HardwareDescription::parse）
+};
+
 class JsonParser {
 public:
-    static std::vector<inputTask> parseJson(const std::string& filename);
+    static std::vector<inputTask> parseJson(const std::string& filename, StringPool& pool);
+
+    // 基于 SAX 的流式读取：不构造 DOM，逐个事件直接填充 inputTask；所有字符串驻留到 pool
+    static std::vector<inputTask> parseJsonStream(const std::string& filename, StringPool& pool);
+
+    // 同上，输入为内存中的完整 JSON 文本（服务模式下的请求体）
+    static std::vector<inputTask> parseJsonBuffer(std::string_view text, StringPool& pool);
+
+    // 服务模式的请求体：任务数组，或 {"planner": "peft", "hardware": {...}, "tasks": [...]}、{"command": "stats"}
+    static std::vector<inputTask> parseRequestBuffer(std::string_view text, StringPool& pool, RequestOptions& options);
 };
 
 #endif // JSONPARSER_H
\ No newline at end of file
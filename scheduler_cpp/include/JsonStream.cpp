@@ -0,0 +1,157 @@
+#include "JsonStream.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+JsonStream::JsonStream(std::string& buffer, std::ostream* sink, bool pretty)
+    : buffer(buffer), sink(sink), pretty(pretty), afterKey(false) {}
+
+void JsonStream::newline(std::size_t depth) {
+    buffer.push_back('\n');
+    buffer.append(depth * 4, ' ');
+}
+
+void JsonStream::beginValue() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (counts.empty()) {
+        return;
+    }
+    if (counts.back()++ > 0) {
+        buffer.push_back(',');
+    }
+    if (pretty) {
+        newline(counts.size());
+    }
+}
+
+void JsonStream::beginArray() {
+    beginValue();
+    buffer.push_back('[');
+    counts.push_back(0);
+}
+
+void JsonStream::beginObject() {
+    beginValue();
+    buffer.push_back('{');
+    counts.push_back(0);
+}
+
+void JsonStream::endContainer(char close) {
+    int count = counts.back();
+    counts.pop_back();
+    if (pretty && count > 0) {
+        newline(counts.size());
+    }
+    buffer.push_back(close);
+    maybeFlush();
+}
+
+void JsonStream::endArray() {
+    endContainer(']');
+}
+
+void JsonStream::endObject() {
+    endContainer('}');
+}
+
+void JsonStream::key(std::string_view name) {
+    beginValue();
+    writeString(name);
+    buffer.append(pretty ? ": " : ":");
+    afterKey = true;
+}
+
+void JsonStream::value(std::string_view text) {
+    beginValue();
+    writeString(text);
+}
+
+void JsonStream::value(long long number) {
+    beginValue();
+    char digits[24];
+    int length = 0;
+    unsigned long long magnitude = number < 0 ? 0ull - static_cast<unsigned long long>(number)
+                                              : static_cast<unsigned long long>(number);
+    do {
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (number < 0) {
+        buffer.push_back('-');
+    }
+    while (length > 0) {
+        buffer.push_back(digits[--length]);
+    }
+}
+
+void JsonStream::value(double number) {
+    // 与 nlohmann 相同：非有限值写 null
+    if (!std::isfinite(number)) {
+        null();
+        return;
+    }
+    beginValue();
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.15g", number);
+    if (std::strtod(text, nullptr) != number) {
+        std::snprintf(text, sizeof(text), "%.17g", number);
+    }
+    buffer.append(text);
+}
+
+void JsonStream::value(bool flag) {
+    beginValue();
+    buffer.append(flag ? "true" : "false");
+}
+
+void JsonStream::null() {
+    beginValue();
+    buffer.append("null");
+}
+
+void JsonStream::writeString(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    buffer.push_back('"');
+    std::size_t plain = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        buffer.append(text.data() + plain, i - plain);
+        plain = i + 1;
+        buffer.push_back('\\');
+        switch (c) {
+        case '"':  buffer.push_back('"'); break;
+        case '\\': buffer.push_back('\\'); break;
+        case '\b': buffer.push_back('b'); break;
+        case '\f': buffer.push_back('f'); break;
+        case '\n': buffer.push_back('n'); break;
+        case '\r': buffer.push_back('r'); break;
+        case '\t': buffer.push_back('t'); break;
+        default:
+            buffer.append("u00");
+            buffer.push_back(hex[c >> 4]);
+            buffer.push_back(hex[c & 0xF]);
+            break;
+        }
+    }
+    buffer.append(text.data() + plain, text.size() - plain);
+    buffer.push_back('"');
+}
+
+void JsonStream::maybeFlush() {
+    if (sink != nullptr && buffer.size() >= kFlushThreshold) {
+        flush();
+    }
+}
+
+void JsonStream::flush() {
+    if (sink != nullptr) {
+        sink->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef JSONSTREAM_H
+#define JSONSTREAM_H
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 不构造 DOM 的 JSON 序列化器：按调用顺序直接写入缓冲区，超过阈值时写到 sink。
+// pretty 模式与 nlohmann::json 的 dump(4) / `os << std::setw(4) << j` 逐字节一致，
+// compact 模式与 dump() 一致。对象的键按调用顺序写出，需要与 nlohmann 一致时由调用者按字典序给出。
+// 字符串按 nlohmann 的规则转义（不转义非 ASCII 字节）。
+class JsonStream {
+public:
+    // sink 为空时所有内容留在 buffer 中
+    JsonStream(std::string& buffer, std::ostream* sink, bool pretty);
+
+    void beginArray();
+    void endArray();
+    void beginObject();
+    void endObject();
+
+    void key(std::string_view name);
+    void value(std::string_view text);
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(long long number);
+    // 可往返的最短十进制表示（15 位不够时用 17 位），不保证与 nlohmann 逐字节一致
+    void value(double number);
+    void value(bool flag);
+    void null();
+
+    // 写出 buffer 中的内容到 sink
+    void flush();
+
+private:
+    static const std::size_t kFlushThreshold = 1 << 20;
+
+    std::string& buffer;
+    std::ostream* sink;
+    bool pretty;
+    bool afterKey;
+    std::vector<int> counts;    // 每层已写出的元素个数
+
+    void beginValue();
+    void endContainer(char close);
+    void newline(std::size_t depth);
+    void writeString(std::string_view text);
+    void maybeFlush();
+};
+
+#endif // JSONSTREAM_H
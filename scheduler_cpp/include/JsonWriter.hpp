@@ -2,16 +2,17 @@
 #define JSONWRITER_H
 
 #include <string>
+#include <string_view>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
 class JsonWriter {
 public:
-    static void writeBinaryToJson(json& jsonData, const std::string& taskId , int port_num, std::string dest_addr, int concat_value, std::string slice_length, std::string slice_data_type, std::string hex_slice_data_dest_str, std::string varname);
-    static void writeBinaryToJson_data_global(json &jsonData, const std::string& Id, std::string addr);
-    static void writeBinaryToJson_data_para(json &jsonData, const std::string& Id, std::string addr, std::string slice_length, std::string slice_data_type, std::string hex_slice_data_dest_str);
-    static void writeBinaryToJson_data(json &jsonData, const std::string& Id,const std::string& taskId, int port_num);
+    static void writeBinaryToJson(json& jsonData, int taskId, int port_num, std::string_view dest_addr, int concat_value, std::string_view slice_length, std::string_view slice_data_type, std::string_view slice_data_dest_str, std::string_view varname);
+    static void writeBinaryToJson_data_global(json &jsonData, std::string_view Id, std::string_view addr);
+    static void writeBinaryToJson_data_para(json &jsonData, std::string_view Id, std::string_view addr, std::string_view slice_length, std::string_view slice_data_type, std::string_view slice_data_dest_str);
+    static void writeBinaryToJson_data(json &jsonData, std::string_view Id, int taskId, int port_num);
 };
 
 #endif // JSONWRITER_H
\ No newline at end of file
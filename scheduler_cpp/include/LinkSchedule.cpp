@@ -0,0 +1,79 @@
+#include "LinkSchedule.hpp"
+#include "Trace.hpp"
+
+namespace {
+
+// 第 hop 跳进入链路的时刻相对发送时刻的偏移
+double hopOffset(const MeshTopology& mesh, int hop) {
+    return mesh.transferOverhead + hop * mesh.hopLatency;
+}
+
+}
+
+void LinkSchedule::reset(const CommModel& model) {
+    comm = &model;
+    links.assign(model.linkCount(), TileTimeline());
+}
+
+void LinkSchedule::clear() {
+    for (auto& link : links) {
+        link.clear();
+    }
+}
+
+double LinkSchedule::earliestSend(int src, int dst, double readyTime, double duration,
+                                  std::vector<double>* enters) const {
+    // 逐跳推迟发送时刻直到所有链路都放得下；发送时刻只增不减，且每次推迟都落到某个空闲时段的起点，
+    // 因此有限步内收敛。比较在链路时间上进行，避免减去偏移再加回时的舍入造成来回推迟
+    const MeshTopology& mesh = comm->topology();
+    double send = readyTime;
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        if (enters != nullptr) {
+            enters->clear();
+        }
+        comm->forEachLink(src, dst, [&](int link, int hop) {
+            double offset = hopOffset(mesh, hop);
+            double enter = send + offset;
+            double free = links[link].earliestStart(enter, duration);
+            if (free > enter && free - offset > send) {
+                send = free - offset;
+                moved = true;
+            }
+            // 最后一轮各跳的 free 即放得下的进入时刻（舍入时可能比 send + offset 晚一个 ulp）
+            if (enters != nullptr) {
+                enters->push_back(free);
+            }
+        });
+    }
+    return send;
+}
+
+double LinkSchedule::arrival(int src, int dst, double readyTime, double bytes) const {
+    if (src == dst) {
+        return readyTime;
+    }
+    double duration = bytes / comm->topology().linkBandwidth;
+    if (!(duration > 0.0)) {
+        return readyTime + comm->cost(src, dst, bytes);
+    }
+    return earliestSend(src, dst, readyTime, duration, nullptr) + comm->cost(src, dst, bytes);
+}
+
+double LinkSchedule::book(int src, int dst, double readyTime, double bytes) {
+    if (src == dst) {
+        return readyTime;
+    }
+    double duration = bytes / comm->topology().linkBandwidth;
+    if (!(duration > 0.0)) {
+        return readyTime + comm->cost(src, dst, bytes);
+    }
+    HEFT_TRACE_COUNT(TransfersBooked, 1);
+    double send = earliestSend(src, dst, readyTime, duration, &hopEnters);
+    // 按 earliestSend 最后一轮查到的位置占用，不再重新查找
+    comm->forEachLink(src, dst, [&](int link, int hop) {
+        links[link].occupy(hopEnters[hop], hopEnters[hop] + duration);
+    });
+    return send + comm->cost(src, dst, bytes);
+}
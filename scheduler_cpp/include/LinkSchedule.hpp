@@ -0,0 +1,36 @@
+#ifndef LINKSCHEDULE_H
+#define LINKSCHEDULE_H
+
+#include "CommModel.hpp"
+#include "TileTimeline.hpp"
+#include <vector>
+
+// 片上网络的链路预约表，每条有向链路一条 TileTimeline（空闲时段的 treap，查找与占用均为 O(log n)）。
+// 跨 TILE 传输按 CommModel 的 XY 路由逐跳占用链路：发送时刻为 s 时，第 k 跳的链路占用
+//   [s + transferOverhead + k * hopLatency, 同上 + bytes / linkBandwidth)
+// 即虫孔式流水，头部每跳前进 hopLatency；到达时间为 s + cost(src, dst, bytes)。
+// s 取不早于数据就绪、且路径上每条链路在对应区间都空闲的最早时刻，链路空闲时与 CommModel::cost 一致。
+// 同一 TILE 内不经过链路；字节数为 0 的传输只计延迟，不占用链路。
+class LinkSchedule {
+public:
+    // 按 comm 的链路数准备空的时间线；comm 须在本对象使用期间有效
+    void reset(const CommModel& comm);
+
+    void clear();
+
+    // 不预约，只求到达时间；可在多个线程中同时调用
+    double arrival(int src, int dst, double readyTime, double bytes) const;
+
+    // 预约路径上的链路并返回到达时间
+    double book(int src, int dst, double readyTime, double bytes);
+
+private:
+    const CommModel* comm = nullptr;
+    std::vector<TileTimeline> links;
+    std::vector<double> hopEnters;      // book 的暂存：各跳进入链路的时刻
+
+    // enters 非空时写入各跳进入链路的时刻，book 按其占用
+    double earliestSend(int src, int dst, double readyTime, double duration, std::vector<double>* enters) const;
+};
+
+#endif // LINKSCHEDULE_H
@@ -0,0 +1,80 @@
+#include "PEFTPlanningAlgorithm.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+const char* PEFTPlanningAlgorithm::name() const {
+    return "peft";
+}
+
+void PEFTPlanningAlgorithm::calculateRanks() {
+    PhaseTimer timer(TracePhase::Rank);
+    computeTopologicalOrder();
+
+    const int n = dag.numTasks;
+    const int tileCount = dag.numTiles;
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // inClass[c * T + p]：TILE p 是否属于能力类 c
+    std::pmr::vector<char> inClass(static_cast<std::size_t>(dag.numClasses()) * tileCount, 0, &scratch);
+    for (int c = 0; c < dag.numClasses(); ++c) {
+        for (int i = dag.classTileOffsets[c]; i < dag.classTileOffsets[c + 1]; ++i) {
+            inClass[static_cast<std::size_t>(c) * tileCount + dag.classTiles[i]] = 1;
+        }
+    }
+
+    // tileBias 即 OCT。lookahead(j, w) = OCT(j, w) + w(j, w)，w 不在 j 的能力类中或不可执行时为无穷；
+    // best[j] 为其最小值。于是 OCT(t, p) = max_j min(best[j] + c(t, j), lookahead(j, p))，
+    // 每条边 O(T)，逆拓扑序单次扫描即可得到整张表
+    tileBias.assign(static_cast<std::size_t>(n) * tileCount, 0.0);
+    std::pmr::vector<double> lookahead(static_cast<std::size_t>(n) * tileCount, infinity, &scratch);
+    std::pmr::vector<double> best(n, infinity, &scratch);
+    rank.assign(n, 0.0);
+    for (auto it = topoOrder.rbegin(); it != topoOrder.rend(); ++it) {
+        int taskId = *it;
+        double* oct = tileBias.data() + static_cast<std::size_t>(taskId) * tileCount;
+        for (int e = dag.childOffsets[taskId]; e < dag.childOffsets[taskId + 1]; ++e) {
+            int childId = dag.childIds[e];
+            if (best[childId] == infinity) {
+                continue;
+            }
+            // 后继放在其他 TILE 上时计期望通信代价，与 t 在同一 TILE 上时不计
+            double elsewhere = best[childId] + comm->averageCost(dag.childBytes[e]);
+            const double* childLookahead = lookahead.data() + static_cast<std::size_t>(childId) * tileCount;
+            for (int p = 0; p < tileCount; ++p) {
+                oct[p] = std::max(oct[p], std::min(elsewhere, childLookahead[p]));
+            }
+        }
+
+        const double* costs = dag.computationRow(taskId);
+        const char* member = inClass.data() + static_cast<std::size_t>(dag.taskClass[taskId]) * tileCount;
+        double* row = lookahead.data() + static_cast<std::size_t>(taskId) * tileCount;
+        double sum = 0.0;
+        int count = 0;
+        for (int p = 0; p < tileCount; ++p) {
+            if (!member[p]) {
+                continue;
+            }
+            sum += oct[p];
+            ++count;
+            if (costs[p] != infinity) {
+                row[p] = oct[p] + costs[p];
+                best[taskId] = std::min(best[taskId], row[p]);
+            }
+        }
+        rank[taskId] = count > 0 ? sum / count : 0.0;
+    }
+    sortByRank();
+}
+
+int PEFTPlanningAlgorithm::replan(const TaskDelta& delta) {
+    if (planned && static_cast<int>(tasks.size()) != dag.numTasks) {
+        throw std::runtime_error("replan needs a planner that ran on a task list, not a .dag file");
+    }
+    std::vector<char> rankSeeds;
+    std::vector<char> placementSeeds;
+    applyDelta(delta, rankSeeds, placementSeeds);
+    run();
+    return dag.numTasks;
+}
@@ -0,0 +1,23 @@
+#ifndef PEFT_PLANNING_ALGORITHM_H
+#define PEFT_PLANNING_ALGORITHM_H
+
+#include "HEFTPlanningAlgorithm.hpp"
+
+// PEFT（Predict Earliest Finish Time, Arabnejad & Barbosa 2014）。在 HEFT 的列表调度框架上：
+// 乐观代价表 OCT(t, p) 为任务 t 放在 TILE p 上之后，其后继链在各自最优 TILE 上完成还需的最短时间；
+// rank 为 t 所在能力类 TILE 上 OCT 的平均值，选择 TILE 时最小化 EFT(t, p) + OCT(t, p)。
+// 与原文一致，后继与 t 在同一 TILE 上时不计传输代价，否则计 CommModel 给出的期望代价。
+class PEFTPlanningAlgorithm : public HEFTPlanningAlgorithm {
+public:
+    using HEFTPlanningAlgorithm::HEFTPlanningAlgorithm;
+
+    const char* name() const override;
+
+    // OCT 的变化会经由任意祖先扩散到其他分支，应用 delta 后整体重新规划
+    int replan(const TaskDelta& delta) override;
+
+protected:
+    void calculateRanks() override;
+};
+
+#endif // PEFT_PLANNING_ALGORITHM_H
@@ -0,0 +1,22 @@
+#include "PlanningAlgorithm.hpp"
+#include "HardwareDescription.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+#include "PEFTPlanningAlgorithm.hpp"
+#include <stdexcept>
+
+const std::vector<std::string>& PlanningAlgorithm::names() {
+    static const std::vector<std::string> planners = {"heft", "peft"};
+    return planners;
+}
+
+std::unique_ptr<PlanningAlgorithm> PlanningAlgorithm::create(std::string_view name, const std::vector<Task>& tasks,
+                                                             const std::shared_ptr<const HardwareDescription>& hardware) {
+    const HardwareDescription& description = hardware ? *hardware : *HardwareDescription::builtin();
+    if (name == "heft") {
+        return std::make_unique<HEFTPlanningAlgorithm>(tasks, description.tiles(), description.comm());
+    }
+    if (name == "peft") {
+        return std::make_unique<PEFTPlanningAlgorithm>(tasks, description.tiles(), description.comm());
+    }
+    throw std::invalid_argument("unknown planner \"" + std::string(name) + "\" (expected heft or peft)");
+}
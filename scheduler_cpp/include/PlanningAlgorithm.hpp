@@ -0,0 +1,52 @@
+#ifndef PLANNING_ALGORITHM_H
+#define PLANNING_ALGORITHM_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct Task;
+struct Tile;
+struct Event;
+class DagFile;
+class HardwareDescription;
+class WorkerPool;
+
+// 规划器的公共接口。run() 之后 getRanks() 给出输出顺序，getTaskEvents() 按任务下标给出分配结果。
+class PlanningAlgorithm {
+public:
+    virtual ~PlanningAlgorithm() = default;
+
+    // 规划器名，同时用作调度结果缓存键的一部分
+    virtual const char* name() const = 0;
+
+    virtual void setWorkerPool(WorkerPool* pool) = 0;
+
+    virtual void run() = 0;
+
+    // 直接由映射的 .dag 文件规划，不构造 Task，忽略构造时给出的任务；getRanks / getTaskEvents 按文件中的任务下标
+    virtual void run(const DagFile& file) = 0;
+
+    // 换一组任务（TILE 不变），之后再 run()。规划器内部的存储在各次规划之间复用
+    virtual void reset(const std::vector<Task>& tasks) = 0;
+
+    virtual const std::vector<std::pair<int, double>>& getRanks() const = 0;
+
+    virtual const std::vector<Event>& getTaskEvents() const = 0;
+
+    virtual double getMakespan() const = 0;
+
+    virtual double getScheduleLengthRatio() const = 0;
+
+    // 可选的规划器名（"heft"、"peft"）
+    static const std::vector<std::string>& names();
+
+    // 名字未知时抛出 std::invalid_argument。hardware 为空时使用 HardwareDescription::builtin()；
+    // 多个规划器共享同一个描述及其通信代价模型
+    static std::unique_ptr<PlanningAlgorithm> create(std::string_view name, const std::vector<Task>& tasks,
+                                                     const std::shared_ptr<const HardwareDescription>& hardware);
+};
+
+#endif // PLANNING_ALGORITHM_H
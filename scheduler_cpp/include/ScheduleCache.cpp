@@ -0,0 +1,278 @@
+#include "ScheduleCache.hpp"
+#include "HardwareDescription.hpp"
+#include "TaskSource.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+const char kFileMagic[8] = {'H', 'E', 'F', 'T', 'S', 'C', 'H', '1'};
+
+std::uint64_t mix(std::uint64_t x) {
+    // splitmix64 的终结函数
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+// 两条独立的 64 位链合成 128 位摘要
+class Digest {
+public:
+    void add(std::uint64_t value) {
+        first = mix(first ^ value) + 0x9e3779b97f4a7c15ull;
+        second = mix(second + value * 0xff51afd7ed558ccdull) ^ 0xc4ceb9fe1a85ec53ull;
+    }
+
+    void add(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        add(bits);
+    }
+
+    void add(std::string_view text) {
+        add(static_cast<std::uint64_t>(text.size()));
+        for (char c : text) {
+            add(static_cast<std::uint64_t>(static_cast<unsigned char>(c)));
+        }
+    }
+
+    std::string hex() const {
+        char text[33];
+        std::snprintf(text, sizeof(text), "%016llx%016llx", static_cast<unsigned long long>(mix(first)),
+                      static_cast<unsigned long long>(mix(second)));
+        return text;
+    }
+
+private:
+    std::uint64_t first = 0x6a09e667f3bcc908ull;
+    std::uint64_t second = 0xbb67ae8584caa73bull;
+};
+
+std::uint64_t capabilityBits(int spm_size, int num_lane, bool has_bitalu, bool has_serdiv, bool has_complexunit) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(spm_size)) << 32) |
+           (static_cast<std::uint64_t>(static_cast<std::uint32_t>(num_lane)) << 3) |
+           (static_cast<std::uint64_t>(has_bitalu) << 2) |
+           (static_cast<std::uint64_t>(has_serdiv) << 1) |
+           static_cast<std::uint64_t>(has_complexunit);
+}
+
+// 与 TaskGraph::build 一致：越界的父任务被忽略，同一父任务的多个端口计入多重集（按端口顺序累加字节数）
+template <typename Source>
+std::string digestOf(const Source& tasks, const HardwareDescription& hardware, std::string_view planner) {
+    Digest d;
+    d.add(planner);
+    const std::vector<Tile>& tiles = hardware.tiles();
+    d.add(static_cast<std::uint64_t>(tiles.size()));
+    for (const auto& tile : tiles) {
+        d.add(static_cast<std::uint64_t>(static_cast<std::uint32_t>(tile.tileId)));
+        d.add(tile.computationCapacity);
+        d.add(capabilityBits(tile.spm_size, tile.num_lane, tile.has_bitalu, tile.has_serdiv, tile.has_complexunit));
+    }
+    const MeshTopology& mesh = hardware.topology();
+    d.add(static_cast<std::uint64_t>(mesh.columns));
+    d.add(mesh.linkBandwidth);
+    d.add(mesh.hopLatency);
+    d.add(mesh.transferOverhead);
+    d.add(static_cast<std::uint64_t>(mesh.contention));
+
+    const int n = tasks.size();
+    d.add(static_cast<std::uint64_t>(n));
+    std::vector<std::pair<int, double>> parents;
+    for (int t = 0; t < n; ++t) {
+        d.add(tasks.cost(t));
+        d.add(capabilityBits(tasks.spmSize(t), tasks.numLane(t), tasks.hasBitalu(t), tasks.hasSerdiv(t),
+                             tasks.hasComplexunit(t)));
+        parents.clear();
+        tasks.forEachParent(t, [&parents, n](int parentId, double bytes) {
+            if (parentId >= 0 && parentId < n) {
+                parents.push_back({parentId, bytes});
+            }
+        });
+        std::stable_sort(parents.begin(), parents.end(),
+                         [](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+                             return a.first < b.first;
+                         });
+        d.add(static_cast<std::uint64_t>(parents.size()));
+        for (const auto& parent : parents) {
+            d.add(static_cast<std::uint64_t>(parent.first));
+            d.add(parent.second);
+        }
+    }
+    return d.hex();
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+}
+
+ScheduleCache::ScheduleCache(std::size_t capacity, std::string directory)
+    : capacity(capacity), directory(std::move(directory)) {}
+
+std::string ScheduleCache::digest(const std::vector<Task>& tasks, const HardwareDescription& hardware,
+                                  std::string_view planner) {
+    return digestOf(TaskListSource(tasks), hardware, planner);
+}
+
+std::string ScheduleCache::digest(const DagFile& file, const HardwareDescription& hardware, std::string_view planner) {
+    return digestOf(DagFileSource(file), hardware, planner);
+}
+
+std::shared_ptr<const CachedSchedule> ScheduleCache::find(const std::string& key, std::size_t taskCount) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            recent.splice(recent.begin(), recent, it->second);
+            ++counters.hits;
+            return it->second->second;
+        }
+        if (directory.empty()) {
+            ++counters.misses;
+            return nullptr;
+        }
+    }
+
+    // 磁盘读取不持锁
+    std::shared_ptr<const CachedSchedule> schedule = readFile(key, taskCount);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!schedule) {
+        ++counters.misses;
+        return nullptr;
+    }
+    ++counters.hits;
+    ++counters.diskHits;
+    insertLocked(key, schedule);
+    return schedule;
+}
+
+void ScheduleCache::insert(const std::string& key, std::shared_ptr<const CachedSchedule> schedule) {
+    bool written = !directory.empty() && writeFile(key, *schedule);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (written) {
+        ++counters.diskWrites;
+    }
+    insertLocked(key, std::move(schedule));
+}
+
+std::shared_ptr<const CachedSchedule> ScheduleCache::getOrPlan(const std::vector<Task>& tasks,
+                                                               const HardwareDescription& hardware,
+                                                               std::string_view planner,
+                                                               const std::function<CachedSchedule()>& plan,
+                                                               bool* hit) {
+    return getOrPlan(digest(tasks, hardware, planner), tasks.size(), plan, hit);
+}
+
+std::shared_ptr<const CachedSchedule> ScheduleCache::getOrPlan(const std::string& key, std::size_t taskCount,
+                                                               const std::function<CachedSchedule()>& plan,
+                                                               bool* hit) {
+    std::shared_ptr<const CachedSchedule> schedule = find(key, taskCount);
+    if (hit != nullptr) {
+        *hit = static_cast<bool>(schedule);
+    }
+    if (!schedule) {
+        schedule = std::make_shared<const CachedSchedule>(plan());
+        insert(key, schedule);
+    }
+    return schedule;
+}
+
+void ScheduleCache::insertLocked(const std::string& key, std::shared_ptr<const CachedSchedule> schedule) {
+    if (capacity == 0) {
+        return;
+    }
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = std::move(schedule);
+        recent.splice(recent.begin(), recent, it->second);
+        return;
+    }
+    recent.emplace_front(key, std::move(schedule));
+    index[key] = recent.begin();
+    while (recent.size() > capacity) {
+        index.erase(recent.back().first);
+        recent.pop_back();
+        ++counters.evictions;
+    }
+}
+
+ScheduleCache::Stats ScheduleCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+std::shared_ptr<const CachedSchedule> ScheduleCache::readFile(const std::string& key, std::size_t taskCount) const {
+    // 文件格式：魔数、任务数，随后为 rank 序列 (taskId, rank) 与按任务下标的事件 (taskId, tileId, start, finish)
+    std::ifstream in(directory + "/" + key + ".sched", std::ios::binary);
+    if (!in.is_open()) {
+        return nullptr;
+    }
+    char magic[sizeof(kFileMagic)];
+    std::uint64_t count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kFileMagic, sizeof(magic)) != 0 ||
+        !readValue(in, count) || count != taskCount) {
+        return nullptr;
+    }
+    auto schedule = std::make_shared<CachedSchedule>();
+    schedule->ranks.resize(count);
+    schedule->taskEvents.resize(count);
+    for (auto& rank : schedule->ranks) {
+        if (!readValue(in, rank.first) || !readValue(in, rank.second) ||
+            rank.first < 0 || static_cast<std::uint64_t>(rank.first) >= count) {
+            return nullptr;
+        }
+    }
+    for (auto& event : schedule->taskEvents) {
+        if (!readValue(in, event.taskId) || !readValue(in, event.tileId) ||
+            !readValue(in, event.start) || !readValue(in, event.finish)) {
+            return nullptr;
+        }
+    }
+    return schedule;
+}
+
+bool ScheduleCache::writeFile(const std::string& key, const CachedSchedule& schedule) const {
+    // 先写临时文件再改名，并发的读者不会看到写了一半的文件
+    std::string path = directory + "/" + key + ".sched";
+    std::string temporary = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(kFileMagic, sizeof(kFileMagic));
+        writeValue(out, static_cast<std::uint64_t>(schedule.taskEvents.size()));
+        for (const auto& rank : schedule.ranks) {
+            writeValue(out, rank.first);
+            writeValue(out, rank.second);
+        }
+        for (const auto& event : schedule.taskEvents) {
+            writeValue(out, event.taskId);
+            writeValue(out, event.tileId);
+            writeValue(out, event.start);
+            writeValue(out, event.finish);
+        }
+        if (!out.flush()) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
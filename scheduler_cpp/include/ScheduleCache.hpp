@@ -0,0 +1,84 @@
+#ifndef SCHEDULECACHE_H
+#define SCHEDULECACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "HEFTPlanningAlgorithm.hpp"
+
+class DagFile;
+class HardwareDescription;
+
+// 一次规划的结果，按任务下标索引，与任务名无关
+struct CachedSchedule {
+    std::vector<std::pair<int, double>> ranks;
+    std::vector<Event> taskEvents;
+};
+
+// 按内容寻址的调度结果缓存。键为规划输入的规范摘要：任务顺序、计算代价、能力需求、父任务及各端口字节数、
+// 硬件描述（TILE 集合与片上网络参数）与规划器名。任务名、地址、hash 等只影响输出而不影响规划的字段不参与摘要，
+// 命中后由 ScheduleEmitter 用本次请求的任务把结果写出。
+// 内存层按条目数 LRU 淘汰；指定目录时未命中会再查磁盘层，规划结果同时写入磁盘
+// （<摘要>.sched，本机字节序）。线程安全。
+class ScheduleCache {
+public:
+    struct Stats {
+        std::uint64_t hits = 0;         // 含磁盘层命中
+        std::uint64_t diskHits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t diskWrites = 0;
+    };
+
+    // capacity 为内存层条目数（0 表示只用磁盘层）；directory 为空表示不使用磁盘层
+    explicit ScheduleCache(std::size_t capacity, std::string directory = "");
+
+    ScheduleCache(const ScheduleCache&) = delete;
+    ScheduleCache& operator=(const ScheduleCache&) = delete;
+
+    // 32 位十六进制（128 位）摘要
+    static std::string digest(const std::vector<Task>& tasks, const HardwareDescription& hardware,
+                              std::string_view planner);
+
+    // .dag 文件与由同一 JSON 输入转换出的任务得到相同的摘要
+    static std::string digest(const DagFile& file, const HardwareDescription& hardware, std::string_view planner);
+
+    // 未命中返回空指针；条目数与 taskCount 不符的磁盘条目视为未命中
+    std::shared_ptr<const CachedSchedule> find(const std::string& key, std::size_t taskCount);
+
+    void insert(const std::string& key, std::shared_ptr<const CachedSchedule> schedule);
+
+    // 命中时返回缓存的结果，否则调用 plan() 并写入缓存；hit 非空时记录是否命中
+    std::shared_ptr<const CachedSchedule> getOrPlan(const std::vector<Task>& tasks, const HardwareDescription& hardware,
+                                                    std::string_view planner,
+                                                    const std::function<CachedSchedule()>& plan, bool* hit = nullptr);
+
+    // 同上，键已由 digest 算出
+    std::shared_ptr<const CachedSchedule> getOrPlan(const std::string& key, std::size_t taskCount,
+                                                    const std::function<CachedSchedule()>& plan, bool* hit = nullptr);
+
+    Stats stats() const;
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const CachedSchedule>>;
+
+    std::size_t capacity;
+    std::string directory;
+    mutable std::mutex mutex;
+    std::list<Entry> recent;            // 表头为最近使用
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    Stats counters;
+
+    void insertLocked(const std::string& key, std::shared_ptr<const CachedSchedule> schedule);
+    std::shared_ptr<const CachedSchedule> readFile(const std::string& key, std::size_t taskCount) const;
+    bool writeFile(const std::string& key, const CachedSchedule& schedule) const;
+};
+
+#endif // SCHEDULECACHE_H
@@ -0,0 +1,438 @@
+#include "ScheduleEmitter.hpp"
+#include "DagFile.hpp"
+#include "JsonWriter.hpp"
+#include "Trace.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// 任务下标 -> 输出编号的反向索引；父任务 "-1" 原样输出，未知任务记为 0
+class OutputIds {
+public:
+    OutputIds(size_t taskCount, const StringPool& pool, const std::unordered_map<Symbol, int>& idMapping,
+              const std::vector<std::pair<int, double>>& ranks)
+        : sequentialIds(taskCount, 0), idMapping(idMapping)
+    {
+        for (size_t count = 0; count < ranks.size(); ++count) {
+            sequentialIds[ranks[count].first] = static_cast<int>(count);
+        }
+        hasNoTask = pool.find("-1", noTask);
+    }
+
+    int operator()(Symbol taskId) const
+    {
+        if (hasNoTask && taskId == noTask) {
+            return -1;
+        }
+        auto found = idMapping.find(taskId);
+        return found != idMapping.end() ? sequentialIds[found->second] : 0;
+    }
+
+private:
+    std::vector<int> sequentialIds;
+    const std::unordered_map<Symbol, int>& idMapping;
+    Symbol noTask = 0;
+    bool hasNoTask = false;
+};
+
+// "0b" + 任务编号低 6 位 + 端口低 4 位，与 JsonWriter 中的 bitset 写法一致
+class PortBits {
+public:
+    PortBits(int taskId, int port)
+    {
+        text[0] = '0';
+        text[1] = 'b';
+        for (int bit = 0; bit < 6; ++bit) {
+            text[2 + bit] = ((static_cast<unsigned>(taskId) >> (5 - bit)) & 1) ? '1' : '0';
+        }
+        for (int bit = 0; bit < 4; ++bit) {
+            text[8 + bit] = ((static_cast<unsigned>(port) >> (3 - bit)) & 1) ? '1' : '0';
+        }
+    }
+
+    std::string_view view() const { return std::string_view(text, sizeof(text)); }
+
+private:
+    char text[12];
+};
+
+// 写入 all_input 的父任务边数；无地址的父任务边只用于调度
+std::size_t addressedParents(const inputTask& task)
+{
+    std::size_t count = 0;
+    for (const auto& parent : task.parentTasks) {
+        count += parent.data.hasAddress;
+    }
+    return count;
+}
+
+// writeOutput 的任务来源。task(i) 返回带 text_offset 等整数字段的记录，字符串字段与各类输入按访问器给出
+class InputTaskEmitSource {
+public:
+    InputTaskEmitSource(const std::vector<inputTask>& tasks, const StringPool& pool,
+                    const std::unordered_map<Symbol, int>& idMapping, const std::vector<std::pair<int, double>>& ranks)
+        : tasks(tasks), pool(pool), outputId(tasks.size(), pool, idMapping, ranks) {}
+
+    const inputTask& task(int index) const { return tasks[index]; }
+
+    std::string_view name(int index) const { return pool.view(tasks[index].taskId); }
+    std::string_view hardwareinfo(int index) const { return pool.view(tasks[index].hardwareinfo); }
+    std::string_view hash(int index) const { return pool.view(tasks[index].hash); }
+
+    std::size_t inputCount(int index) const {
+        const inputTask& task = tasks[index];
+        return addressedParents(task) + task.global_Input.size() + task.para_Input.size();
+    }
+
+    bool hasReturnOutput(int index) const { return !tasks[index].return_output.empty(); }
+
+    template <typename Visit>
+    void forEachGlobal(int index, Visit visit) const {
+        for (const auto& global : tasks[index].global_Input) {
+            visit(pool.view(global.name), pool.view(global.destAddress));
+        }
+    }
+
+    template <typename Visit>
+    void forEachPara(int index, Visit visit) const {
+        for (const auto& para : tasks[index].para_Input) {
+            const EdgePort& port = para.data;
+            visit(pool.view(para.name), pool.view(port.destAddressText), pool.view(port.sliceLengthText),
+                  pool.view(port.sliceDataTypeText), port.sliceDataDest);
+        }
+    }
+
+    // visit(输出编号, 端口, concat_value, dest_address, name, slice_length, slice_data_type, slice_data_dest)
+    template <typename Visit>
+    void forEachParent(int index, Visit visit) const {
+        for (const auto& parent : tasks[index].parentTasks) {
+            const EdgePort& port = parent.data;
+            if (!port.hasAddress) {
+                continue;
+            }
+            visit(outputId(parent.taskId), parent.port, parent.concatValue, pool.view(port.destAddressText),
+                  pool.view(parent.varName), pool.view(port.sliceLengthText), pool.view(port.sliceDataTypeText),
+                  port.sliceDataDest);
+        }
+    }
+
+    template <typename Visit>
+    void forEachReturn(int index, Visit visit) const {
+        for (const auto& output : tasks[index].return_output) {
+            visit(pool.view(output.name), output.port);
+        }
+    }
+
+private:
+    const std::vector<inputTask>& tasks;
+    const StringPool& pool;
+    OutputIds outputId;
+};
+
+class DagFileEmitSource {
+public:
+    DagFileEmitSource(const DagFile& file, const std::vector<std::pair<int, double>>& ranks)
+        : file(file), sequentialIds(file.taskCount(), 0) {
+        for (size_t count = 0; count < ranks.size(); ++count) {
+            sequentialIds[ranks[count].first] = static_cast<int>(count);
+        }
+    }
+
+    const DagTaskRecord& task(int index) const { return file.task(index); }
+
+    std::string_view name(int index) const { return file.string(file.task(index).name); }
+    std::string_view hardwareinfo(int index) const { return file.string(file.task(index).hardwareinfo); }
+    std::string_view hash(int index) const { return file.string(file.task(index).hash); }
+
+    std::size_t inputCount(int index) const {
+        std::size_t parents = 0;
+        for (const DagParentRecord* parent = file.parentsBegin(index); parent != file.parentsEnd(index); ++parent) {
+            parents += dagParentHasAddress(*parent);
+        }
+        return parents + file.globalCount(index) + file.paraCount(index);
+    }
+
+    bool hasReturnOutput(int index) const { return file.returnsBegin(index) != file.returnsEnd(index); }
+
+    template <typename Visit>
+    void forEachGlobal(int index, Visit visit) const {
+        for (const DagGlobalRecord* global = file.globalsBegin(index); global != file.globalsEnd(index); ++global) {
+            visit(file.string(global->name), file.string(global->destAddress));
+        }
+    }
+
+    template <typename Visit>
+    void forEachPara(int index, Visit visit) const {
+        for (const DagParaRecord* para = file.parasBegin(index); para != file.parasEnd(index); ++para) {
+            visit(file.string(para->name), file.string(para->destAddressText), file.string(para->sliceLengthText),
+                  file.string(para->sliceDataTypeText), para->sliceDataDest);
+        }
+    }
+
+    template <typename Visit>
+    void forEachParent(int index, Visit visit) const {
+        for (const DagParentRecord* parent = file.parentsBegin(index); parent != file.parentsEnd(index); ++parent) {
+            if (!dagParentHasAddress(*parent)) {
+                continue;
+            }
+            int outputId = parent->task >= 0 ? sequentialIds[parent->task] : parent->task == kDagNoTask ? -1 : 0;
+            visit(outputId, parent->port, parent->concatValue, file.string(parent->destAddressText),
+                  file.string(parent->varName), file.string(parent->sliceLengthText),
+                  file.string(parent->sliceDataTypeText), parent->sliceDataDest);
+        }
+    }
+
+    template <typename Visit>
+    void forEachReturn(int index, Visit visit) const {
+        for (const DagReturnRecord* output = file.returnsBegin(index); output != file.returnsEnd(index); ++output) {
+            visit(file.string(output->name), output->port);
+        }
+    }
+
+private:
+    const DagFile& file;
+    std::vector<int> sequentialIds;
+};
+
+template <typename Source>
+void writeTasks(JsonStream& out, const Source& source, const std::vector<std::pair<int, double>>& ranks,
+                const std::vector<Event>& taskEvents)
+{
+    PhaseTimer timer(TracePhase::Emit);
+    bool hasReturnOutput = false;
+
+    // 键按字典序写出，与 nlohmann::json 对象的顺序一致
+    out.beginArray();
+    for (size_t count = 0; count < ranks.size(); ++count) {
+        int taskIndex = ranks[count].first;
+        const auto& task = source.task(taskIndex);
+        const Event& event = taskEvents[taskIndex];
+        hasReturnOutput = hasReturnOutput || source.hasReturnOutput(taskIndex);
+
+        out.beginObject();
+        out.key("Input_Num");
+        std::size_t inputCount = source.inputCount(taskIndex);
+        out.value(static_cast<long long>(inputCount));
+        out.key("Output_Num");
+        out.value(static_cast<long long>(task.output_num));
+        out.key("all_input");
+        if (inputCount == 0) {
+            out.value("None");
+        } else {
+            out.beginArray();
+            source.forEachGlobal(taskIndex, [&out](std::string_view name, std::string_view destAddress) {
+                out.beginObject();
+                out.key("dest_address");
+                out.value(destAddress);
+                out.key("name");
+                out.value(name);
+                out.key("parentTasksPort");
+                out.value("0b0000000000");
+                out.endObject();
+            });
+            source.forEachPara(taskIndex, [&out](std::string_view name, std::string_view destAddress,
+                                                 std::string_view sliceLength, std::string_view sliceDataType,
+                                                 uint32_t sliceDataDest) {
+                out.beginObject();
+                out.key("dest_address");
+                out.value(destAddress);
+                out.key("name");
+                out.value(name);
+                out.key("parentTasksPort");
+                out.value("0b0000000000");
+                out.key("slice_data_dest_str");
+                out.value(HexText(sliceDataDest).view());
+                out.key("slice_data_type");
+                out.value(sliceDataType);
+                out.key("slice_length");
+                out.value(sliceLength);
+                out.endObject();
+            });
+            source.forEachParent(taskIndex, [&out](int parentId, int port, int concatValue,
+                                                   std::string_view destAddress, std::string_view name,
+                                                   std::string_view sliceLength, std::string_view sliceDataType,
+                                                   uint32_t sliceDataDest) {
+                char parentText[16];
+                int parentLength = std::snprintf(parentText, sizeof(parentText), "%d", parentId);
+                out.beginObject();
+                out.key("concat_value");
+                out.value(static_cast<long long>(concatValue));
+                out.key("dest_address");
+                out.value(destAddress);
+                out.key("name");
+                out.value(name);
+                out.key("parentTasks");
+                out.value(std::string_view(parentText, parentLength));
+                out.key("parentTasksPort");
+                out.value(PortBits(parentId, port).view());
+                out.key("slice_data_dest_str");
+                out.value(HexText(sliceDataDest).view());
+                out.key("slice_data_type");
+                out.value(sliceDataType);
+                out.key("slice_length");
+                out.value(sliceLength);
+                out.key("type");
+                out.value("0b00");
+                out.endObject();
+            });
+            out.endArray();
+        }
+        out.key("core_id");
+        out.value(static_cast<long long>(event.tileId));
+        out.key("current_taskId");
+        out.value(static_cast<long long>(count));
+        out.key("data_length");
+        out.value(static_cast<long long>(task.data_length));
+        out.key("data_offset");
+        out.value(static_cast<long long>(task.data_offset));
+        out.key("debug_task_name");
+        out.value(source.name(taskIndex));
+        out.key("finish_cycle");
+        out.value(ScheduleEmitter::toCycle(event.finish));
+        out.key("hardwareinfo");
+        out.value(source.hardwareinfo(taskIndex));
+        out.key("hash");
+        out.value(source.hash(taskIndex));
+        out.key("start_cycle");
+        out.value(ScheduleEmitter::toCycle(event.start));
+        out.key("text_length");
+        out.value(static_cast<long long>(task.text_length));
+        out.key("text_offset");
+        out.value(static_cast<long long>(task.text_offset));
+        out.key("total_length");
+        out.value(static_cast<long long>(task.total_length));
+        out.endObject();
+    }
+
+    // return_output 汇总所有任务，放在最后
+    if (ranks.empty()) {
+        out.null();
+    } else {
+        out.beginObject();
+        out.key("return_output");
+        if (!hasReturnOutput) {
+            out.value("None");
+        } else {
+            out.beginArray();
+            for (size_t count = 0; count < ranks.size(); ++count) {
+                source.forEachReturn(ranks[count].first, [&out, count](std::string_view name, int port) {
+                    char taskText[16];
+                    int taskLength = std::snprintf(taskText, sizeof(taskText), "%d", static_cast<int>(count));
+                    out.beginObject();
+                    out.key("name");
+                    out.value(name);
+                    out.key("parentTasks");
+                    out.value(std::string_view(taskText, taskLength));
+                    out.key("parentTasksPort");
+                    out.value(PortBits(static_cast<int>(count), port).view());
+                    out.endObject();
+                });
+            }
+            out.endArray();
+        }
+        out.endObject();
+    }
+    out.endArray();
+    out.flush();
+}
+
+}
+
+long long ScheduleEmitter::toCycle(double time)
+{
+    return std::isfinite(time) ? std::llround(time) : -1;
+}
+
+json ScheduleEmitter::buildOutput(const std::vector<inputTask>& inputTasks, const StringPool& pool,
+                                  const std::unordered_map<Symbol, int>& idMapping,
+                                  const std::vector<std::pair<int, double>>& ranks,
+                                  const std::vector<Event>& taskEvents)
+{
+    PhaseTimer timer(TracePhase::Emit);
+    OutputIds sequentialId(inputTasks.size(), pool, idMapping, ranks);
+
+    json outputJson = json::array();
+    json returnJson;
+    json returnJson_info;
+
+    for (size_t count = 0; count < ranks.size(); ++count) {
+        int taskIndex = ranks[count].first;
+        const inputTask& task = inputTasks[taskIndex];
+        const Event& event = taskEvents[taskIndex];
+        json taskJson;
+        json parentTasksJson;
+
+        taskJson["debug_task_name"] = std::string(pool.view(task.taskId));
+        taskJson["core_id"]        = event.tileId;
+        taskJson["start_cycle"]    = toCycle(event.start);
+        taskJson["finish_cycle"]   = toCycle(event.finish);
+        taskJson["current_taskId"] = count;
+        taskJson["text_offset"]    = task.text_offset;
+        taskJson["data_offset"]    = task.data_offset;
+        taskJson["total_length"]   = task.total_length;
+        taskJson["text_length"]    = task.text_length;
+        taskJson["data_length"]    = task.data_length;
+        taskJson["hardwareinfo"]   = std::string(pool.view(task.hardwareinfo)); // last 5 bits :spm_size lane_num has_serdiv has_complexunit has_bitalu
+        taskJson["hash"]           = std::string(pool.view(task.hash));
+        taskJson["Input_Num"]      = addressedParents(task) + task.global_Input.size() + task.para_Input.size();
+        taskJson["Output_Num"]     = task.output_num;
+
+        for (const auto& global : task.global_Input) {
+            JsonWriter::writeBinaryToJson_data_global(parentTasksJson, pool.view(global.name), pool.view(global.destAddress));
+        }
+
+        for (const auto& para : task.para_Input) {
+            const EdgePort& port = para.data;
+            JsonWriter::writeBinaryToJson_data_para(parentTasksJson, pool.view(para.name), pool.view(port.destAddressText),
+                                                    pool.view(port.sliceLengthText), pool.view(port.sliceDataTypeText),
+                                                    HexText(port.sliceDataDest).view());
+        }
+
+        for (const auto& output : task.return_output) {
+            JsonWriter::writeBinaryToJson_data(returnJson_info, pool.view(output.name), static_cast<int>(count), output.port);
+        }
+
+        for (const auto& parent : task.parentTasks) {
+            const EdgePort& port = parent.data;
+            if (!port.hasAddress) {
+                continue;
+            }
+            JsonWriter::writeBinaryToJson(parentTasksJson, sequentialId(parent.taskId), parent.port,
+                                          pool.view(port.destAddressText), parent.concatValue,
+                                          pool.view(port.sliceLengthText), pool.view(port.sliceDataTypeText),
+                                          HexText(port.sliceDataDest).view(), pool.view(parent.varName));
+        }
+
+        if (parentTasksJson.empty())
+            taskJson["all_input"] = "None";
+        else
+            taskJson["all_input"] = std::move(parentTasksJson);
+
+        outputJson.push_back(std::move(taskJson));
+    }
+    // return_output 汇总所有任务，只在最后写入一次
+    if (!ranks.empty()) {
+        if (returnJson_info.empty())
+            returnJson["return_output"] = "None";
+        else
+            returnJson["return_output"] = std::move(returnJson_info);
+    }
+    outputJson.push_back(std::move(returnJson));
+    return outputJson;
+}
+
+void ScheduleEmitter::writeOutput(JsonStream& out, const std::vector<inputTask>& inputTasks, const StringPool& pool,
+                                  const std::unordered_map<Symbol, int>& idMapping,
+                                  const std::vector<std::pair<int, double>>& ranks,
+                                  const std::vector<Event>& taskEvents)
+{
+    writeTasks(out, InputTaskEmitSource(inputTasks, pool, idMapping, ranks), ranks, taskEvents);
+}
+
+void ScheduleEmitter::writeOutput(JsonStream& out, const DagFile& file,
+                                  const std::vector<std::pair<int, double>>& ranks,
+                                  const std::vector<Event>& taskEvents)
+{
+    writeTasks(out, DagFileEmitSource(file, ranks), ranks, taskEvents);
+}
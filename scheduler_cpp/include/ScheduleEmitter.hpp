@@ -0,0 +1,41 @@
+#ifndef SCHEDULEEMITTER_H
+#define SCHEDULEEMITTER_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "HEFTPlanningAlgorithm.hpp"
+#include "JsonStream.hpp"
+#include "StringPool.hpp"
+
+using json = nlohmann::json;
+
+class DagFile;
+
+// 组装调度结果 JSON：任务按 rank 顺序重新编号为 0..n-1 依次输出，最后追加 return_output。
+// 整数 taskId 为 TaskConverter 分配的下标，与 inputTasks 的下标一一对应。
+// 一次遍历完成，O(V + E)。
+class ScheduleEmitter {
+public:
+    // 流式输出，不构造 json 树；pretty 模式与 buildOutput(...).dump(4) 逐字节一致（由 bench/emit_bench 校验）
+    static void writeOutput(JsonStream& out, const std::vector<inputTask>& inputTasks, const StringPool& pool,
+                            const std::unordered_map<Symbol, int>& idMapping,
+                            const std::vector<std::pair<int, double>>& ranks,
+                            const std::vector<Event>& taskEvents);
+
+    // 同上，任务来自映射的 .dag 文件；与由同一 JSON 输入得到的输出逐字节一致
+    static void writeOutput(JsonStream& out, const DagFile& file, const std::vector<std::pair<int, double>>& ranks,
+                            const std::vector<Event>& taskEvents);
+
+    // 以 nlohmann::json 树的形式构造同样的输出，作为 writeOutput 的对照（bench/emit_bench）
+    static json buildOutput(const std::vector<inputTask>& inputTasks, const StringPool& pool,
+                            const std::unordered_map<Symbol, int>& idMapping,
+                            const std::vector<std::pair<int, double>>& ranks,
+                            const std::vector<Event>& taskEvents);
+
+    // 调度时间换算为周期数；无法执行的任务（完成时间为无穷）记为 -1
+    static long long toCycle(double time);
+};
+
+#endif // SCHEDULEEMITTER_H
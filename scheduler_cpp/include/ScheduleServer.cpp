@@ -0,0 +1,269 @@
+#include "ScheduleServer.hpp"
+#include "JsonParser.hpp"
+#include "PlanningAlgorithm.hpp"
+#include "ScheduleEmitter.hpp"
+#include "TaskConverter.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// 套接字设置了 SO_RCVTIMEO / SO_SNDTIMEO，超时（EAGAIN）与出错一样返回 false
+bool readFully(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool writeFully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool writeFrame(int fd, const std::string& payload) {
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    unsigned char header[4] = {
+        static_cast<unsigned char>(size >> 24), static_cast<unsigned char>(size >> 16),
+        static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size)
+    };
+    return writeFully(fd, reinterpret_cast<const char*>(header), sizeof(header)) &&
+           writeFully(fd, payload.data(), payload.size());
+}
+
+std::string errorPayload(const std::string& message) {
+    json error;
+    error["error"] = message;
+    return error.dump();
+}
+
+std::string commandPayload(const std::string& command, const ScheduleCache* cache) {
+    if (command != "stats") {
+        return errorPayload("unknown command: " + command);
+    }
+    json stats;
+    if (cache != nullptr) {
+        ScheduleCache::Stats counters = cache->stats();
+        stats["cache"] = {
+            {"hits", counters.hits},
+            {"disk_hits", counters.diskHits},
+            {"misses", counters.misses},
+            {"evictions", counters.evictions},
+            {"disk_writes", counters.diskWrites}
+        };
+    } else {
+        stats["cache"] = nullptr;
+    }
+    return stats.dump();
+}
+
+}
+
+ScheduleServer::ScheduleServer(const std::string& socketPath, std::shared_ptr<const HardwareDescription> hardware,
+                               int handlerCount, ScheduleCache* cache, const std::string& defaultPlanner)
+    : socketPath(socketPath), hardware(std::move(hardware)), handlerCount(handlerCount < 1 ? 1 : handlerCount),
+      cache(cache), defaultPlanner(defaultPlanner), listenFd(-1), epollFd(-1), stopping(false) {}
+
+ScheduleServer::~ScheduleServer() {
+    // 先让处理线程退出（正在处理的请求最多因读写超时而结束），再关闭它们用到的描述符
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (auto& handler : handlers) {
+        handler.join();
+    }
+    for (int fd : readyConnections) {
+        ::close(fd);
+    }
+    if (epollFd >= 0) {
+        ::close(epollFd);
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+    }
+}
+
+void ScheduleServer::run() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("socket path too long: " + socketPath);
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (listenFd < 0 || epollFd < 0) {
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    }
+    // 上次异常退出遗留的套接字文件
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listenFd, SOMAXCONN) < 0) {
+        throw std::runtime_error("cannot listen on " + socketPath + ": " + std::strerror(errno));
+    }
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listenFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent);
+
+    for (int i = 0; i < handlerCount; ++i) {
+        handlers.emplace_back(&ScheduleServer::handlerLoop, this);
+    }
+
+    epoll_event events[64];
+    while (true) {
+        int count = ::epoll_wait(epollFd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("epoll_wait: ") + std::strerror(errno));
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                int connection = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (connection >= 0) {
+                    timeval timeout{kIoTimeoutSeconds, 0};
+                    ::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                    ::setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLONESHOT;
+                    event.data.fd = connection;
+                    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, connection, &event);
+                }
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                readyConnections.push_back(fd);
+            }
+            ready.notify_one();
+        }
+    }
+}
+
+void ScheduleServer::handlerLoop() {
+    std::string payload;
+    while (true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return stopping || !readyConnections.empty(); });
+            if (stopping) {
+                return;
+            }
+            fd = readyConnections.front();
+            readyConnections.pop_front();
+        }
+        if (!serveRequest(fd, payload)) {
+            ::close(fd);
+            continue;
+        }
+        // 应答写完后重新等待该连接上的下一个请求
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+}
+
+bool ScheduleServer::serveRequest(int fd, std::string& payload) {
+    unsigned char header[4];
+    if (!readFully(fd, reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    uint32_t size = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) |
+                    (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+    if (size > kMaxFrameSize) {
+        writeFrame(fd, errorPayload("request frame too large"));
+        return false;
+    }
+    payload.resize(size);
+    if (!readFully(fd, &payload[0], size)) {
+        return false;
+    }
+    return writeFrame(fd, handleRequest(payload, hardware, cache, defaultPlanner));
+}
+
+std::string ScheduleServer::schedule(std::string_view payload,
+                                     const std::shared_ptr<const HardwareDescription>& hardware, ScheduleCache* cache,
+                                     std::string_view defaultPlanner) {
+    StringPool pool;
+    RequestOptions options;
+    std::vector<inputTask> inputTasks = JsonParser::parseRequestBuffer(payload, pool, options);
+    if (!options.command.empty()) {
+        throw std::invalid_argument("command payloads are not schedule requests");
+    }
+    return scheduleTasks(inputTasks, pool, options, defaultPlanner, hardware, cache);
+}
+
+std::string ScheduleServer::handleRequest(const std::string& payload,
+                                          const std::shared_ptr<const HardwareDescription>& hardware,
+                                          ScheduleCache* cache, std::string_view defaultPlanner) {
+    try {
+        StringPool pool;
+        RequestOptions options;
+        std::vector<inputTask> inputTasks = JsonParser::parseRequestBuffer(payload, pool, options);
+        if (!options.command.empty()) {
+            return commandPayload(options.command, cache);
+        }
+        return scheduleTasks(inputTasks, pool, options, defaultPlanner, hardware, cache);
+    } catch (const std::exception& e) {
+        return errorPayload(e.what());
+    }
+}
+
+std::string ScheduleServer::scheduleTasks(const std::vector<inputTask>& inputTasks, StringPool& pool,
+                                          const RequestOptions& options, std::string_view defaultPlanner,
+                                          const std::shared_ptr<const HardwareDescription>& hardware,
+                                          ScheduleCache* cache) {
+    std::string_view planner = options.planner.empty() ? defaultPlanner : std::string_view(options.planner);
+    std::shared_ptr<const HardwareDescription> target =
+        !options.hardware.empty() ? HardwareDescription::parse(options.hardware)
+                                  : hardware ? hardware : HardwareDescription::builtin();
+    auto result = TaskConverter::convertToTasks(inputTasks);
+
+    auto plan = [&result, &target, planner]() {
+        std::unique_ptr<PlanningAlgorithm> algorithm = PlanningAlgorithm::create(planner, result.first, target);
+        algorithm->run();
+        return CachedSchedule{algorithm->getRanks(), algorithm->getTaskEvents()};
+    };
+    std::shared_ptr<const CachedSchedule> planned =
+        cache != nullptr ? cache->getOrPlan(result.first, *target, planner, plan)
+                         : std::make_shared<const CachedSchedule>(plan());
+
+    std::string output;
+    JsonStream out(output, nullptr, true);
+    ScheduleEmitter::writeOutput(out, inputTasks, pool, result.second, planned->ranks, planned->taskEvents);
+    return output;
+}
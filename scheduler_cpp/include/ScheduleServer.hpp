@@ -0,0 +1,77 @@
+#ifndef SCHEDULESERVER_H
+#define SCHEDULESERVER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "HardwareDescription.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+#include "ScheduleCache.hpp"
+
+struct RequestOptions;
+
+// 常驻调度服务：监听 Unix 域套接字，每个连接上可连续发送多个请求。
+// 帧格式：4 字节大端长度 + 负载。请求负载与输入文件格式相同（任务数组 JSON），
+// 或 {"planner": "peft", "hardware": {...}, "tasks": [...]} 为单个请求指定规划器（缺省为 defaultPlanner）
+// 与硬件描述（格式见 HardwareDescription，缺省为启动时给出的描述；相同的描述只解析一次）；
+// 应答负载为与输出文件相同的调度结果，失败时为 {"error": "..."}。
+// 调用 run() 的线程用 epoll 等待新连接与可读连接（EPOLLONESHOT），可读的连接交给
+// handlerCount 个常驻线程读取请求、规划并写回应答，之后重新登记。空闲连接不占用处理线程；
+// 已开始发送请求的连接读写超过 kIoTimeoutSeconds 秒没有进展时关闭，不完整的帧不会一直占住处理线程。
+// 处理线程由对象持有，析构时通知其退出并等待（run() 抛出异常后同样如此）。
+// 硬件描述只读共享，每个请求使用独立的规划器。给出 cache 时相同的规划输入直接复用缓存结果；
+// 负载为 {"command": "stats"} 时返回缓存计数。
+class ScheduleServer {
+public:
+    ScheduleServer(const std::string& socketPath, std::shared_ptr<const HardwareDescription> hardware,
+                   int handlerCount, ScheduleCache* cache = nullptr, const std::string& defaultPlanner = "heft");
+    ~ScheduleServer();
+
+    ScheduleServer(const ScheduleServer&) = delete;
+    ScheduleServer& operator=(const ScheduleServer&) = delete;
+
+    // 阻塞运行；套接字创建失败时抛出 std::runtime_error
+    void run();
+
+    // 完整流程：解析、转换、规划、输出，与文件模式的输出逐字节一致；失败时抛出异常
+    static std::string schedule(std::string_view payload, const std::shared_ptr<const HardwareDescription>& hardware,
+                                ScheduleCache* cache = nullptr, std::string_view defaultPlanner = "heft");
+
+    // 处理一个请求负载（含命令），返回应答负载
+    static std::string handleRequest(const std::string& payload,
+                                     const std::shared_ptr<const HardwareDescription>& hardware,
+                                     ScheduleCache* cache = nullptr, std::string_view defaultPlanner = "heft");
+
+private:
+    static const uint32_t kMaxFrameSize = 1u << 30;
+    static const int kIoTimeoutSeconds = 10;
+
+    std::string socketPath;
+    std::shared_ptr<const HardwareDescription> hardware;
+    int handlerCount;
+    ScheduleCache* cache;
+    std::string defaultPlanner;
+    int listenFd;
+    int epollFd;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<int> readyConnections;
+    bool stopping;
+    std::vector<std::thread> handlers;
+
+    void handlerLoop();
+    bool serveRequest(int fd, std::string& payload);
+
+    static std::string scheduleTasks(const std::vector<inputTask>& inputTasks, StringPool& pool,
+                                     const RequestOptions& options, std::string_view defaultPlanner,
+                                     const std::shared_ptr<const HardwareDescription>& hardware, ScheduleCache* cache);
+};
+
+#endif // SCHEDULESERVER_H
@@ -0,0 +1,237 @@
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HEFT_SIMD_X86 1
+#else
+#define HEFT_SIMD_X86 0
+#endif
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+struct KernelTable {
+    void (*divideCosts)(double, const double*, double*, int);
+    void (*finiteRowSums)(const double*, int, int, double*);
+    double (*addMin)(const double*, const double*, double*, int);
+};
+
+// ---- 标量实现：也是其余实现的参照 ----
+
+void divideCostsScalar(double cost, const double* capacity, double* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] = capacity[i] < cost ? kInfinity : cost / capacity[i];
+    }
+}
+
+double finiteSumScalar(const double* values, int n) {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        if (values[i] != kInfinity) {
+            sum += values[i];
+        }
+    }
+    return sum;
+}
+
+void finiteRowSumsScalar(const double* matrix, int rows, int cols, double* out) {
+    for (int r = 0; r < rows; ++r) {
+        out[r] = finiteSumScalar(matrix + static_cast<std::size_t>(r) * cols, cols);
+    }
+}
+
+double addMinScalar(const double* a, const double* b, double* sum, int n) {
+    double minimum = kInfinity;
+    for (int i = 0; i < n; ++i) {
+        sum[i] = a[i] + b[i];
+        minimum = std::min(minimum, sum[i]);
+    }
+    return minimum;
+}
+
+const KernelTable kScalarTable = {divideCostsScalar, finiteRowSumsScalar, addMinScalar};
+
+#if HEFT_SIMD_X86
+
+// ---- SSE2：x86-64 的基线指令集，无需运行时检测 ----
+
+void divideCostsSSE2(double cost, const double* capacity, double* out, int n) {
+    const __m128d costs = _mm_set1_pd(cost);
+    const __m128d infinity = _mm_set1_pd(kInfinity);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d c = _mm_loadu_pd(capacity + i);
+        __m128d unsatisfiable = _mm_cmplt_pd(c, costs);
+        __m128d quotient = _mm_div_pd(costs, c);
+        _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(unsatisfiable, infinity), _mm_andnot_pd(unsatisfiable, quotient)));
+    }
+    divideCostsScalar(cost, capacity + i, out + i, n - i);
+}
+
+void finiteRowSumsSSE2(const double* matrix, int rows, int cols, double* out) {
+    // 每条通道对应一行，行内仍按列顺序累加
+    const __m128d infinity = _mm_set1_pd(kInfinity);
+    int r = 0;
+    for (; r + 2 <= rows; r += 2) {
+        const double* row0 = matrix + static_cast<std::size_t>(r) * cols;
+        const double* row1 = row0 + cols;
+        __m128d sum = _mm_setzero_pd();
+        for (int p = 0; p < cols; ++p) {
+            __m128d v = _mm_set_pd(row1[p], row0[p]);
+            sum = _mm_add_pd(sum, _mm_and_pd(_mm_cmpneq_pd(v, infinity), v));
+        }
+        _mm_storeu_pd(out + r, sum);
+    }
+    finiteRowSumsScalar(matrix + static_cast<std::size_t>(r) * cols, rows - r, cols, out + r);
+}
+
+double addMinSSE2(const double* a, const double* b, double* sum, int n) {
+    __m128d minimum = _mm_set1_pd(kInfinity);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d s = _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        _mm_storeu_pd(sum + i, s);
+        minimum = _mm_min_pd(minimum, s);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, minimum);
+    return std::min(std::min(lanes[0], lanes[1]), addMinScalar(a + i, b + i, sum + i, n - i));
+}
+
+const KernelTable kSSE2Table = {divideCostsSSE2, finiteRowSumsSSE2, addMinSSE2};
+
+// ---- AVX2：运行时检测到支持时才调用 ----
+
+__attribute__((target("avx2"))) void divideCostsAVX2(double cost, const double* capacity, double* out, int n) {
+    const __m256d costs = _mm256_set1_pd(cost);
+    const __m256d infinity = _mm256_set1_pd(kInfinity);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d c = _mm256_loadu_pd(capacity + i);
+        __m256d unsatisfiable = _mm256_cmp_pd(c, costs, _CMP_LT_OQ);
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(_mm256_div_pd(costs, c), infinity, unsatisfiable));
+    }
+    divideCostsScalar(cost, capacity + i, out + i, n - i);
+}
+
+__attribute__((target("avx2"))) void finiteRowSumsAVX2(const double* matrix, int rows, int cols, double* out) {
+    const __m256d infinity = _mm256_set1_pd(kInfinity);
+    int r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        const double* row0 = matrix + static_cast<std::size_t>(r) * cols;
+        const double* row1 = row0 + cols;
+        const double* row2 = row1 + cols;
+        const double* row3 = row2 + cols;
+        __m256d sum = _mm256_setzero_pd();
+        for (int p = 0; p < cols; ++p) {
+            __m256d v = _mm256_set_pd(row3[p], row2[p], row1[p], row0[p]);
+            sum = _mm256_add_pd(sum, _mm256_and_pd(_mm256_cmp_pd(v, infinity, _CMP_NEQ_UQ), v));
+        }
+        _mm256_storeu_pd(out + r, sum);
+    }
+    finiteRowSumsScalar(matrix + static_cast<std::size_t>(r) * cols, rows - r, cols, out + r);
+}
+
+__attribute__((target("avx2"))) double addMinAVX2(const double* a, const double* b, double* sum, int n) {
+    __m256d minimum = _mm256_set1_pd(kInfinity);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d s = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        _mm256_storeu_pd(sum + i, s);
+        minimum = _mm256_min_pd(minimum, s);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, minimum);
+    double tail = addMinScalar(a + i, b + i, sum + i, n - i);
+    return std::min(std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3])), tail);
+}
+
+const KernelTable kAVX2Table = {divideCostsAVX2, finiteRowSumsAVX2, addMinAVX2};
+
+#endif
+
+SimdKernels::Level detectLevel() {
+#if HEFT_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdKernels::Level::AVX2;
+    }
+    return SimdKernels::Level::SSE2;
+#else
+    return SimdKernels::Level::Scalar;
+#endif
+}
+
+const KernelTable* tableFor(SimdKernels::Level level) {
+#if HEFT_SIMD_X86
+    if (level == SimdKernels::Level::AVX2) {
+        return &kAVX2Table;
+    }
+    if (level == SimdKernels::Level::SSE2) {
+        return &kSSE2Table;
+    }
+#endif
+    (void)level;
+    return &kScalarTable;
+}
+
+const SimdKernels::Level kSupported = detectLevel();
+std::atomic<SimdKernels::Level> currentLevel(kSupported);
+std::atomic<const KernelTable*> currentTable(tableFor(kSupported));
+
+const KernelTable& kernels() {
+    return *currentTable.load(std::memory_order_relaxed);
+}
+
+}
+
+SimdKernels::Level SimdKernels::level() {
+    return currentLevel.load(std::memory_order_relaxed);
+}
+
+SimdKernels::Level SimdKernels::supported() {
+    return kSupported;
+}
+
+SimdKernels::Level SimdKernels::setLevel(Level requested) {
+    Level level = std::min(requested, kSupported);
+    currentLevel.store(level, std::memory_order_relaxed);
+    currentTable.store(tableFor(level), std::memory_order_relaxed);
+    return level;
+}
+
+const char* SimdKernels::name(Level level) {
+    switch (level) {
+    case Level::AVX2: return "avx2";
+    case Level::SSE2: return "sse2";
+    default:          return "scalar";
+    }
+}
+
+void SimdKernels::divideCosts(double cost, const double* capacity, double* out, int n) {
+    kernels().divideCosts(cost, capacity, out, n);
+}
+
+void SimdKernels::finiteRowAverages(const double* matrix, int rows, int cols, double* out) {
+    if (cols == 0) {
+        std::fill(out, out + rows, 0.0);
+        return;
+    }
+    kernels().finiteRowSums(matrix, rows, cols, out);
+    for (int r = 0; r < rows; ++r) {
+        out[r] /= cols;
+    }
+}
+
+int SimdKernels::addArgmin(const double* a, const double* b, double* sum, int n) {
+    double minimum = kernels().addMin(a, b, sum, n);
+    int i = 0;
+    while (i + 1 < n && sum[i] != minimum) {
+        ++i;
+    }
+    return i;
+}
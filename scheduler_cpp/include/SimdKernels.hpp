@@ -0,0 +1,33 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+// 规划热路径上的向量化内核。启动时按 CPU 选择 AVX2 / SSE2 / 标量实现，三者对同一输入给出逐位相同的结果，
+// 也与原来逐个元素计算的结果相同：各行的求和不改变累加顺序，向量通道对应不同的行。
+// 非 x86 平台只有标量实现。
+class SimdKernels {
+public:
+    enum class Level { Scalar, SSE2, AVX2 };
+
+    // 当前使用的实现
+    static Level level();
+
+    // CPU 支持的最高实现
+    static Level supported();
+
+    // 切换实现（基准测试用），高于 supported() 时取 supported()；返回实际使用的实现
+    static Level setLevel(Level requested);
+
+    static const char* name(Level level);
+
+    // out[i] = capacity[i] < cost ? +inf : cost / capacity[i]
+    static void divideCosts(double cost, const double* capacity, double* out, int n);
+
+    // 行主序 rows × cols 矩阵逐行求平均：不等于 +inf 的项按列顺序求和后除以 cols（cols 为 0 时为 0）。
+    // 每行的累加是一条依赖链，向量化在行之间进行；矩阵应在缓存中（见 TaskGraph::build 的分块）
+    static void finiteRowAverages(const double* matrix, int rows, int cols, double* out);
+
+    // sum[i] = a[i] + b[i]，返回 sum 最小的第一个下标；n 须大于 0
+    static int addArgmin(const double* a, const double* b, double* sum, int n);
+};
+
+#endif // SIMDKERNELS_H
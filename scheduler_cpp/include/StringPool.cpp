@@ -0,0 +1,78 @@
+#include "StringPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+StringPool::StringPool() : blockUsed(0), blockCapacity(0), slots(1024, 0) {
+    strings.push_back(std::string_view());
+    hashes.push_back(0);
+}
+
+std::size_t StringPool::probe(std::string_view text, std::size_t hash) const {
+    std::size_t mask = slots.size() - 1;
+    std::size_t slot = hash & mask;
+    while (slots[slot] != 0) {
+        Symbol candidate = slots[slot];
+        if (hashes[candidate] == hash && strings[candidate] == text) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool StringPool::find(std::string_view text, Symbol& symbol) const {
+    if (text.empty()) {
+        symbol = 0;
+        return true;
+    }
+    symbol = slots[probe(text, std::hash<std::string_view>()(text))];
+    return symbol != 0;
+}
+
+Symbol StringPool::intern(std::string_view text) {
+    if (text.empty()) {
+        return 0;
+    }
+    std::size_t hash = std::hash<std::string_view>()(text);
+    std::size_t slot = probe(text, hash);
+    if (slots[slot] != 0) {
+        return slots[slot];
+    }
+
+    Symbol symbol = static_cast<Symbol>(strings.size());
+    strings.push_back(std::string_view(store(text), text.size()));
+    hashes.push_back(hash);
+    slots[slot] = symbol;
+    // 装载率保持在 1/2 以下
+    if (strings.size() * 2 > slots.size()) {
+        grow();
+    }
+    return symbol;
+}
+
+void StringPool::grow() {
+    std::vector<Symbol> larger(slots.size() * 2, 0);
+    std::size_t mask = larger.size() - 1;
+    for (Symbol symbol = 1; symbol < strings.size(); ++symbol) {
+        std::size_t slot = hashes[symbol] & mask;
+        while (larger[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        larger[slot] = symbol;
+    }
+    slots.swap(larger);
+}
+
+const char* StringPool::store(std::string_view text) {
+    if (blockUsed + text.size() > blockCapacity) {
+        // 超长字符串单独占一块
+        blockCapacity = std::max(kBlockSize, text.size());
+        blocks.emplace_back(new char[blockCapacity]);
+        blockUsed = 0;
+    }
+    char* destination = blocks.back().get() + blockUsed;
+    std::memcpy(destination, text.data(), text.size());
+    blockUsed += text.size();
+    return destination;
+}
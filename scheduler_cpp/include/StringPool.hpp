@@ -0,0 +1,51 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using Symbol = uint32_t;
+
+// 字符串驻留池：相同内容只存一份，以 32 位 Symbol 引用。
+// 字符数据按块追加、从不搬移，view() 返回的 string_view 在池的生命周期内一直有效。
+// 索引为开放寻址表，新字符串只追加数据，不为每个字符串单独分配结点。
+// Symbol 0 固定为空串。
+class StringPool {
+public:
+    StringPool();
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    Symbol intern(std::string_view text);
+
+    // 只查找不插入；不存在时返回 false
+    bool find(std::string_view text, Symbol& symbol) const;
+
+    std::string_view view(Symbol symbol) const {
+        return strings[symbol];
+    }
+
+    std::size_t size() const {
+        return strings.size();
+    }
+
+private:
+    static const std::size_t kBlockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t blockUsed;
+    std::size_t blockCapacity;
+    std::vector<std::string_view> strings;
+    std::vector<std::size_t> hashes;    // 按 Symbol 索引，扩容时无需重新计算
+    std::vector<Symbol> slots;          // 0 表示空槽，长度为 2 的幂
+
+    const char* store(std::string_view text);
+    std::size_t probe(std::string_view text, std::size_t hash) const;   // 命中的槽或应插入的空槽
+    void grow();
+};
+
+#endif // STRINGPOOL_H
@@ -1,9 +1,15 @@
 #include "TaskConverter.hpp"
+#include "Trace.hpp"
+#include <stdexcept>
+#include <string>
 
-std::pair<std::vector<Task>, std::unordered_map<std::string, int>> TaskConverter::convertToTasks(const std::vector<inputTask> &inputTasks)
+std::pair<std::vector<Task>, std::unordered_map<Symbol, int>> TaskConverter::convertToTasks(const std::vector<inputTask> &inputTasks)
 {
-    std::unordered_map<std::string, int> idMapping;
+    PhaseTimer timer(TracePhase::Convert);
+    std::unordered_map<Symbol, int> idMapping;
     std::vector<Task> tasks;
+    idMapping.reserve(inputTasks.size());
+    tasks.reserve(inputTasks.size());
 
     // Create a mapping between string IDs and integer IDs
     for (const auto &inputTask : inputTasks)
@@ -31,47 +37,92 @@ std::pair<std::vector<Task>, std::unordered_map<std::string, int>> TaskConverter
         newTask.output_num      = inputTask.output_num;
 
         // Convert parentTasks and childTasks to integer IDs
+        newTask.parentTasks.reserve(inputTask.parentTasks.size());
         for (const auto &parent : inputTask.parentTasks)
-        {   
-            auto parent_id = std::get<0>(parent);
-            int portIndex = std::get<1>(parent);
-            auto dest_address = std::get<2>(parent);
-            int concat_value = std::get<3>(parent);
-            auto slice_length = std::get<4>(parent);
-            auto slice_data_type = std::get<5>(parent);
-            auto varname = std::get<6>(parent);
-            if (idMapping.find(parent_id) != idMapping.end())
+        {
+            auto it = idMapping.find(parent.taskId);
+            if (it != idMapping.end())
             {
-                newTask.parentTasks.push_back({idMapping[parent_id], portIndex, dest_address, concat_value, slice_length, slice_data_type, varname}); // Port Index set to 0
+                newTask.parentTasks.push_back({it->second, parent.port, parent.data, parent.concatValue, parent.varName});
             }
             else
             {
                 // If the parent ID is not found, keep it unchanged (-1)
-                newTask.parentTasks.push_back({-1, 0, 0, 0, 0, 0, 0}); // Port Index set to 0
+                newTask.parentTasks.push_back({-1, 0, EdgePort(), 0, 0}); // Port Index set to 0
             }
         }
 
+        newTask.childTasks.reserve(inputTask.childTasks.size());
         for (const auto &child : inputTask.childTasks)
-        {   
-            std::string child_id = std::get<0>(child);
-            int portIndex = std::get<1>(child);
-            std::string dest_address = std::get<2>(child);
-            int concat_value = std::get<3>(child);
-            std::string slice_length = std::get<4>(child);
-            std::string slice_data_type = std::get<5>(child);
-            std::string varname = std::get<6>(child);
-            if (idMapping.find(child_id) != idMapping.end())
+        {
+            auto it = idMapping.find(child.taskId);
+            if (it != idMapping.end())
             {
-                newTask.childTasks.push_back({idMapping[child_id], portIndex ,dest_address, concat_value, slice_length, slice_data_type, varname}); // Port Index set to 0
+                newTask.childTasks.push_back({it->second, child.port, child.data, child.concatValue, child.varName});
             }
             else
             {
-                newTask.childTasks.push_back({-1, 0, 0, 0, 0, 0, 0}); // Port Index set to 0
+                newTask.childTasks.push_back({-1, 0, EdgePort(), 0, 0}); // Port Index set to 0
             }
         }
 
-        tasks.push_back(newTask);
+        tasks.push_back(std::move(newTask));
     }
 
-    return {tasks, idMapping};
+    return {std::move(tasks), std::move(idMapping)};
+}
+
+std::vector<Task> TaskConverter::buildTasks(int taskCount, const double* costs,
+                                            const int* spmSize, const int* numLane, const int* features,
+                                            int edgeCount, const int* edgeSource, const int* edgeTarget,
+                                            const int* edgeBytes)
+{
+    PhaseTimer timer(TracePhase::Convert);
+    std::vector<Task> tasks(taskCount);
+    for (int i = 0; i < taskCount; ++i)
+    {
+        Task& task = tasks[i];
+        task.taskId          = i;
+        task.computationCost = costs[i];
+        task.spm_size        = spmSize[i];
+        task.num_lane        = numLane[i];
+        task.has_bitalu      = (features[i] & 1) != 0;
+        task.has_serdiv      = (features[i] & 2) != 0;
+        task.has_complexunit = (features[i] & 4) != 0;
+        task.address         = 0;
+        task.length          = 0;
+        task.text_offset     = 0;
+        task.data_offset     = 0;
+        task.total_length    = 0;
+        task.text_length     = 0;
+        task.data_length     = 0;
+        task.output_num      = 0;
+        task.hardwareinfo    = 0;
+        task.hash            = 0;
+    }
+
+    for (int k = 0; k < edgeCount; ++k)
+    {
+        int source = edgeSource[k];
+        int target = edgeTarget[k];
+        if (source < 0 || source >= taskCount || target < 0 || target >= taskCount)
+        {
+            throw std::invalid_argument("edge " + std::to_string(k) + " references a task outside [0, " +
+                                        std::to_string(taskCount) + ")");
+        }
+        EdgePort data;
+        if (edgeBytes != nullptr)
+        {
+            if (edgeBytes[k] < 0)
+            {
+                throw std::invalid_argument("edge " + std::to_string(k) + " has a negative byte count");
+            }
+            data.sliceLength = static_cast<uint32_t>(edgeBytes[k]);
+            data.sliceDataType = 1;
+        }
+        tasks[target].parentTasks.push_back({source, 0, data, 0, 0});
+        tasks[source].childTasks.push_back({target, 0, EdgePort(), 0, 0});
+        ++tasks[source].output_num;
+    }
+    return tasks;
 }
@@ -8,7 +8,16 @@
 
 class TaskConverter {
 public:
-    static std::pair<std::vector<Task>, std::unordered_map<std::string, int>> convertToTasks(const std::vector<inputTask>& inputTasks);
+    static std::pair<std::vector<Task>, std::unordered_map<Symbol, int>> convertToTasks(const std::vector<inputTask>& inputTasks);
+
+    // 由扁平数组直接构造 Task：任务 i 的计算量为 costs[i]，第 k 条边为 edgeSource[k] -> edgeTarget[k]。
+    // spmSize/numLane/features 为每个任务的能力需求，features 按位为 bitalu(1) serdiv(2) complexunit(4)。
+    // edgeBytes 非空时为每条边传输的字节数（记为 1 字节元素的切片），否则为 0。
+    // 下标越界或字节数为负时抛出 std::invalid_argument
+    static std::vector<Task> buildTasks(int taskCount, const double* costs,
+                                        const int* spmSize, const int* numLane, const int* features,
+                                        int edgeCount, const int* edgeSource, const int* edgeTarget,
+                                        const int* edgeBytes = nullptr);
 };
 
 #endif // TASKCONVERTER_H
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "TaskGraph.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+#include "Capability.hpp"
+#include "SimdKernels.hpp"
+#include "TaskSource.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// 生成代价矩阵时每块的元素数（约 32 KB，留在 L1/L2 中）
+const int kAverageBlockElements = 4096;
+
+template <typename Source>
+void buildGraph(const Source& tasks, const std::vector<Tile>& tiles, TaskGraph& g,
+                std::pmr::memory_resource* scratch) {
+    g.numTasks = tasks.size();
+    g.numTiles = static_cast<int>(tiles.size());
+    const int n = g.numTasks;
+
+    // 父邻接：以 parentTasks 为准，-1 或越界的父任务忽略
+    g.parentOffsets.assign(n + 1, 0);
+    for (int t = 0; t < n; ++t) {
+        tasks.forEachParent(t, [&](int parentId, double) {
+            if (parentId >= 0 && parentId < n) {
+                g.parentOffsets[t + 1]++;
+            }
+        });
+    }
+    for (int t = 0; t < n; ++t) {
+        g.parentOffsets[t + 1] += g.parentOffsets[t];
+    }
+    std::pmr::vector<std::pair<int, double>> edges(g.parentOffsets[n], scratch);
+    for (int t = 0; t < n; ++t) {
+        int pos = g.parentOffsets[t];
+        tasks.forEachParent(t, [&](int parentId, double bytes) {
+            if (parentId >= 0 && parentId < n) {
+                edges[pos++] = {parentId, bytes};
+            }
+        });
+    }
+
+    // 同一父任务经多个端口连接时合并为一条边（一次传输），字节数按端口顺序累加
+    g.parentIds.resize(edges.size());
+    g.parentBytes.resize(edges.size());
+    int out = 0;
+    for (int t = 0; t < n; ++t) {
+        int begin = g.parentOffsets[t];
+        int end = g.parentOffsets[t + 1];
+        std::stable_sort(edges.begin() + begin, edges.begin() + end,
+                         [](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+                             return a.first < b.first;
+                         });
+        g.parentOffsets[t] = out;
+        for (int e = begin; e < end;) {
+            int parentId = edges[e].first;
+            double bytes = 0.0;
+            while (e < end && edges[e].first == parentId) {
+                bytes += edges[e].second;
+                ++e;
+            }
+            g.parentIds[out] = parentId;
+            g.parentBytes[out] = bytes;
+            ++out;
+        }
+    }
+    g.parentOffsets[n] = out;
+    g.parentIds.resize(out);
+    g.parentBytes.resize(out);
+
+    // 子邻接由父邻接转置得到，每行按子任务下标升序
+    g.childOffsets.assign(n + 1, 0);
+    for (int e = 0; e < out; ++e) {
+        g.childOffsets[g.parentIds[e] + 1]++;
+    }
+    for (int t = 0; t < n; ++t) {
+        g.childOffsets[t + 1] += g.childOffsets[t];
+    }
+    g.childIds.resize(out);
+    g.childBytes.resize(out);
+    std::pmr::vector<int> cursor(g.childOffsets.begin(), g.childOffsets.end() - 1, scratch);
+    for (int t = 0; t < n; ++t) {
+        for (int e = g.parentOffsets[t]; e < g.parentOffsets[t + 1]; ++e) {
+            int pos = cursor[g.parentIds[e]]++;
+            g.childIds[pos] = t;
+            g.childBytes[pos] = g.parentBytes[e];
+        }
+    }
+
+    // 算力不足的 TILE 代价为无穷。按块生成代价行并趁其仍在缓存中求平均代价
+    std::pmr::vector<double> capacities(g.numTiles, scratch);
+    for (int p = 0; p < g.numTiles; ++p) {
+        capacities[p] = tiles[p].computationCapacity;
+    }
+    g.computationCosts.resize(static_cast<std::size_t>(n) * g.numTiles);
+    g.averageCosts.resize(n);
+    const int blockRows = std::max(4, (kAverageBlockElements / std::max(1, g.numTiles)) & ~3);
+    for (int first = 0; first < n; first += blockRows) {
+        int rows = std::min(blockRows, n - first);
+        double* block = g.computationCosts.data() + static_cast<std::size_t>(first) * g.numTiles;
+        for (int r = 0; r < rows; ++r) {
+            SimdKernels::divideCosts(tasks.cost(first + r), capacities.data(),
+                                     block + static_cast<std::size_t>(r) * g.numTiles, g.numTiles);
+        }
+        SimdKernels::finiteRowAverages(block, rows, g.numTiles, g.averageCosts.data() + first);
+    }
+
+    // 能力类：按 TILE 首次出现的顺序编号
+    std::pmr::unordered_map<uint64_t, int> classOfKey(scratch);
+    std::pmr::vector<int> tileClass(g.numTiles, scratch);
+    for (int p = 0; p < g.numTiles; ++p) {
+        const Tile& tile = tiles[p];
+        if (!capabilityInRange(tile.spm_size, tile.num_lane)) {
+            throw std::invalid_argument("tile " + std::to_string(tile.tileId) + " has out-of-range spm_size/num_lane");
+        }
+        uint64_t key = packCapability(tile.spm_size, tile.num_lane, tile.has_serdiv, tile.has_complexunit, tile.has_bitalu);
+        auto it = classOfKey.emplace(key, static_cast<int>(classOfKey.size())).first;
+        tileClass[p] = it->second;
+    }
+    g.classTileOffsets.assign(classOfKey.size() + 1, 0);
+    for (int p = 0; p < g.numTiles; ++p) {
+        g.classTileOffsets[tileClass[p] + 1]++;
+    }
+    for (std::size_t c = 0; c < classOfKey.size(); ++c) {
+        g.classTileOffsets[c + 1] += g.classTileOffsets[c];
+    }
+    g.classTiles.resize(g.numTiles);
+    std::pmr::vector<int> classCursor(g.classTileOffsets.begin(), g.classTileOffsets.end() - 1, scratch);
+    for (int p = 0; p < g.numTiles; ++p) {
+        g.classTiles[classCursor[tileClass[p]]++] = p;
+    }
+
+    g.taskClass.assign(n, -1);
+    g.unmatchedTasks.clear();
+    g.infeasibleTasks.clear();
+    for (int t = 0; t < n; ++t) {
+        if (capabilityInRange(tasks.spmSize(t), tasks.numLane(t))) {
+            uint64_t key = packCapability(tasks.spmSize(t), tasks.numLane(t), tasks.hasSerdiv(t),
+                                          tasks.hasComplexunit(t), tasks.hasBitalu(t));
+            auto it = classOfKey.find(key);
+            if (it != classOfKey.end()) {
+                g.taskClass[t] = it->second;
+            }
+        }
+        if (g.taskClass[t] < 0) {
+            g.unmatchedTasks.push_back(t);
+            continue;
+        }
+        const double* row = g.computationCosts.data() + static_cast<std::size_t>(t) * g.numTiles;
+        bool feasible = false;
+        for (int i = g.classTileOffsets[g.taskClass[t]]; i < g.classTileOffsets[g.taskClass[t] + 1] && !feasible; ++i) {
+            feasible = row[g.classTiles[i]] != std::numeric_limits<double>::infinity();
+        }
+        if (!feasible) {
+            g.infeasibleTasks.push_back(t);
+        }
+    }
+}
+
+}
+
+TaskGraph TaskGraph::build(const std::vector<Task>& tasks, const std::vector<Tile>& tiles) {
+    TaskGraph g;
+    build(tasks, tiles, g, std::pmr::get_default_resource());
+    return g;
+}
+
+void TaskGraph::build(const std::vector<Task>& tasks, const std::vector<Tile>& tiles, TaskGraph& graph,
+                      std::pmr::memory_resource* scratch) {
+    buildGraph(TaskListSource(tasks), tiles, graph, scratch);
+}
+
+void TaskGraph::build(const DagFile& file, const std::vector<Tile>& tiles, TaskGraph& graph,
+                      std::pmr::memory_resource* scratch) {
+    buildGraph(DagFileSource(file), tiles, graph, scratch);
+}
+
+bool TaskGraph::topologicalOrder(std::vector<int>& order, std::pmr::memory_resource* scratch) const {
+    std::pmr::vector<int> inDegree(numTasks, scratch);
+    for (int t = 0; t < numTasks; ++t) {
+        inDegree[t] = parentCount(t);
+    }
+
+    // order 同时充当 FIFO 队列
+    order.clear();
+    order.reserve(numTasks);
+    for (int t = 0; t < numTasks; ++t) {
+        if (inDegree[t] == 0) {
+            order.push_back(t);
+        }
+    }
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        int current = order[head];
+        for (int e = childOffsets[current]; e < childOffsets[current + 1]; ++e) {
+            if (--inDegree[childIds[e]] == 0) {
+                order.push_back(childIds[e]);
+            }
+        }
+    }
+    return static_cast<int>(order.size()) == numTasks;
+}
+
+std::vector<int> TaskGraph::findCycle() const {
+    std::vector<int> order;
+    if (topologicalOrder(order)) {
+        return {};
+    }
+    std::vector<char> ordered(numTasks, 0);
+    for (int t : order) {
+        ordered[t] = 1;
+    }
+
+    // 未排序的任务都至少有一个未排序的父任务，沿父边回溯必然回到走过的任务
+    int start = 0;
+    while (ordered[start]) {
+        ++start;
+    }
+    std::vector<int> step(numTasks, -1);
+    std::vector<int> path;
+    int current = start;
+    while (step[current] < 0) {
+        step[current] = static_cast<int>(path.size());
+        path.push_back(current);
+        for (int e = parentOffsets[current]; e < parentOffsets[current + 1]; ++e) {
+            if (!ordered[parentIds[e]]) {
+                current = parentIds[e];
+                break;
+            }
+        }
+    }
+    std::vector<int> cycle(path.begin() + step[current], path.end());
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+}
@@ -0,0 +1,68 @@
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+struct Task;
+struct Tile;
+class DagFile;
+
+// 紧凑的 DAG 表示：任务按下标连续存放，父/子邻接为 CSR（带每条边传输的字节数，代价由 CommModel 按放置求出），
+// 计算代价为 tasks × tiles 的行主序平铺矩阵。内存与构建时间均为 O(V + E + V·T)。
+struct TaskGraph {
+    int numTasks = 0;
+    int numTiles = 0;
+
+    std::vector<int> parentOffsets;     // numTasks + 1
+    std::vector<int> parentIds;
+    std::vector<double> parentBytes;   // parent -> task 传输的字节数
+
+    std::vector<int> childOffsets;      // numTasks + 1
+    std::vector<int> childIds;
+    std::vector<double> childBytes;    // task -> child 传输的字节数
+
+    std::vector<double> computationCosts; // numTasks * numTiles
+    std::vector<double> averageCosts;     // 每行的平均代价：不可执行（无穷）的 TILE 不计入求和，但计入分母
+
+    // 能力类：能力键相同的 TILE 归为一类，任务只需遍历所属类的 TILE
+    std::vector<int> taskClass;         // -1 表示没有任何 TILE 与该任务匹配
+    std::vector<int> classTileOffsets;  // numClasses + 1
+    std::vector<int> classTiles;        // TILE 下标，类内升序
+    std::vector<int> unmatchedTasks;
+    std::vector<int> infeasibleTasks;   // 有匹配的 TILE，但在其中任何一个上代价都为无穷
+
+    static TaskGraph build(const std::vector<Task>& tasks, const std::vector<Tile>& tiles);
+
+    // 在 graph 原有的存储上重建（复用各数组的容量）；构建用的临时数组从 scratch 分配
+    static void build(const std::vector<Task>& tasks, const std::vector<Tile>& tiles, TaskGraph& graph,
+                      std::pmr::memory_resource* scratch);
+
+    // 直接由映射的 .dag 文件构建，不经过 Task；结果与由其转换出的 Task 构建相同
+    static void build(const DagFile& file, const std::vector<Tile>& tiles, TaskGraph& graph,
+                      std::pmr::memory_resource* scratch);
+
+    // Kahn 拓扑排序；图中有环时返回 false，order 只包含可排序的前缀
+    bool topologicalOrder(std::vector<int>& order,
+                          std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
+
+    // 返回图中一个环上的任务（按边方向），无环时为空
+    std::vector<int> findCycle() const;
+
+    double computationCost(int task, int tile) const {
+        return computationCosts[static_cast<std::size_t>(task) * numTiles + tile];
+    }
+
+    const double* computationRow(int task) const {
+        return computationCosts.data() + static_cast<std::size_t>(task) * numTiles;
+    }
+
+    int numClasses() const { return static_cast<int>(classTileOffsets.size()) - 1; }
+
+    int parentCount(int task) const { return parentOffsets[task + 1] - parentOffsets[task]; }
+
+    int childCount(int task) const { return childOffsets[task + 1] - childOffsets[task]; }
+};
+
+#endif // TASKGRAPH_H
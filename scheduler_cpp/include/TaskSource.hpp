@@ -0,0 +1,58 @@
+#ifndef TASKSOURCE_H
+#define TASKSOURCE_H
+
+#include <vector>
+#include "DagFile.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+
+// 规划输入的统一只读访问：内存中的 Task 列表或映射的 .dag 文件。
+// TaskGraph::build 与 ScheduleCache::digest 以模板方式使用，两种来源得到相同的结果。
+// forEachParent 按端口顺序给出原始的父任务下标与该端口传输的字节数（slice_length * slice_data_type），
+// 负数或越界的下标由调用者忽略。
+class TaskListSource {
+public:
+    explicit TaskListSource(const std::vector<Task>& tasks) : tasks(tasks) {}
+
+    int size() const { return static_cast<int>(tasks.size()); }
+    double cost(int t) const { return tasks[t].computationCost; }
+    int spmSize(int t) const { return tasks[t].spm_size; }
+    int numLane(int t) const { return tasks[t].num_lane; }
+    bool hasBitalu(int t) const { return tasks[t].has_bitalu; }
+    bool hasSerdiv(int t) const { return tasks[t].has_serdiv; }
+    bool hasComplexunit(int t) const { return tasks[t].has_complexunit; }
+
+    template <typename Visit>
+    void forEachParent(int t, Visit visit) const {
+        for (const auto& parent : tasks[t].parentTasks) {
+            visit(parent.taskId, static_cast<double>(parent.data.sliceLength) * parent.data.sliceDataType);
+        }
+    }
+
+private:
+    const std::vector<Task>& tasks;
+};
+
+class DagFileSource {
+public:
+    explicit DagFileSource(const DagFile& file) : file(file) {}
+
+    int size() const { return file.taskCount(); }
+    double cost(int t) const { return file.task(t).computationCost; }
+    int spmSize(int t) const { return file.task(t).spm_size; }
+    int numLane(int t) const { return file.task(t).num_lane; }
+    bool hasBitalu(int t) const { return (file.task(t).capability & kDagBitalu) != 0; }
+    bool hasSerdiv(int t) const { return (file.task(t).capability & kDagSerdiv) != 0; }
+    bool hasComplexunit(int t) const { return (file.task(t).capability & kDagComplexunit) != 0; }
+
+    template <typename Visit>
+    void forEachParent(int t, Visit visit) const {
+        for (const DagParentRecord* parent = file.parentsBegin(t); parent != file.parentsEnd(t); ++parent) {
+            visit(parent->task, static_cast<double>(parent->bytes));
+        }
+    }
+
+private:
+    const DagFile& file;
+};
+
+#endif // TASKSOURCE_H
@@ -0,0 +1,197 @@
+#include "TileTimeline.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+}
+
+TileTimeline::TileTimeline() : root(-1) {
+    clear();
+}
+
+void TileTimeline::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    seed = 2463534242u;
+    root = newNode(0.0, kInfinity);
+}
+
+void TileTimeline::rebuild(const std::vector<std::pair<double, double>>& busy) {
+    // 空闲时段为相邻占用区间之间的间隔（含长度为 0 的），按起点顺序用栈构造 treap（笛卡尔树）
+    nodes.clear();
+    freeNodes.clear();
+    std::vector<int> spine;
+    double gapStart = 0.0;
+    for (std::size_t i = 0; i <= busy.size(); ++i) {
+        double gapEnd = i < busy.size() ? busy[i].first : kInfinity;
+        int node = newNode(gapStart, gapEnd);
+        int last = -1;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[node].priority) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        nodes[node].left = last;
+        if (!spine.empty()) {
+            nodes[spine.back()].right = node;
+        }
+        spine.push_back(node);
+        if (i < busy.size()) {
+            gapStart = busy[i].second;
+        }
+    }
+    root = spine.front();
+    updateSubtree(root);
+}
+
+void TileTimeline::updateSubtree(int node) {
+    if (node < 0) {
+        return;
+    }
+    updateSubtree(nodes[node].left);
+    updateSubtree(nodes[node].right);
+    update(node);
+}
+
+int TileTimeline::gapCount() const {
+    return static_cast<int>(nodes.size() - freeNodes.size());
+}
+
+int TileTimeline::newNode(double start, double end) {
+    // xorshift32：固定种子保证多次运行结果一致
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    // length 是剪枝用的上界：放大几个 ulp，保证 start + duration <= end 成立的 gap 不会被剪掉。
+    // 两端同为无穷时按 0 计，避免 inf - inf
+    double length = (start == end) ? 0.0 : end - start;
+    length += 4 * std::numeric_limits<double>::epsilon() * (length + std::fabs(end));
+    Node node{start, end, length, length, -1, -1, seed};
+    if (!freeNodes.empty()) {
+        int index = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void TileTimeline::update(int node) {
+    Node& n = nodes[node];
+    n.maxLength = n.length;
+    if (n.left >= 0) {
+        n.maxLength = std::max(n.maxLength, nodes[n.left].maxLength);
+    }
+    if (n.right >= 0) {
+        n.maxLength = std::max(n.maxLength, nodes[n.right].maxLength);
+    }
+}
+
+int TileTimeline::merge(int a, int b) {
+    // a 中所有 gap 在时间线上位于 b 之前
+    if (a < 0) {
+        return b;
+    }
+    if (b < 0) {
+        return a;
+    }
+    if (nodes[a].priority > nodes[b].priority) {
+        nodes[a].right = merge(nodes[a].right, b);
+        update(a);
+        return a;
+    }
+    nodes[b].left = merge(a, nodes[b].left);
+    update(b);
+    return b;
+}
+
+void TileTimeline::splitAfter(int node, double key, int& left, int& right) {
+    // left 为起点 <= key 的 gap，right 为其余
+    if (node < 0) {
+        left = right = -1;
+        return;
+    }
+    if (nodes[node].start <= key) {
+        splitAfter(nodes[node].right, key, nodes[node].right, right);
+        left = node;
+    } else {
+        splitAfter(nodes[node].left, key, left, nodes[node].left);
+        right = node;
+    }
+    update(node);
+}
+
+int TileTimeline::popRightmost(int& tree) {
+    if (nodes[tree].right < 0) {
+        int node = tree;
+        tree = nodes[node].left;
+        return node;
+    }
+    int node = popRightmost(nodes[tree].right);
+    update(tree);
+    return node;
+}
+
+int TileTimeline::firstFitAfter(int node, double readyTime, double duration) const {
+    // 起点晚于 readyTime 且长度 >= duration 的最左 gap
+    while (node >= 0 && nodes[node].maxLength >= duration) {
+        HEFT_TRACE_COUNT(GapsScanned, 1);
+        const Node& n = nodes[node];
+        if (n.start <= readyTime) {
+            node = n.right;
+            continue;
+        }
+        int found = firstFitAfter(n.left, readyTime, duration);
+        if (found >= 0) {
+            return found;
+        }
+        if (n.start + duration <= n.end) {
+            return node;
+        }
+        node = n.right;
+    }
+    return -1;
+}
+
+double TileTimeline::earliestStart(double readyTime, double duration) const {
+    // 先看包含 readyTime 的 gap（起点 <= readyTime 的最后一个），放得下就从 readyTime 开始
+    HEFT_TRACE_COUNT(SlotProbes, 1);
+    int node = root;
+    int containing = -1;
+    while (node >= 0) {
+        HEFT_TRACE_COUNT(GapsScanned, 1);
+        if (nodes[node].start <= readyTime) {
+            containing = node;
+            node = nodes[node].right;
+        } else {
+            node = nodes[node].left;
+        }
+    }
+    if (containing >= 0 && readyTime + duration <= nodes[containing].end) {
+        return readyTime;
+    }
+
+    int found = firstFitAfter(root, readyTime, duration);
+    return found >= 0 ? nodes[found].start : kInfinity;
+}
+
+void TileTimeline::occupy(double start, double finish) {
+    HEFT_TRACE_COUNT(SlotsOccupied, 1);
+    int left;
+    int right;
+    splitAfter(root, start, left, right);
+    int gap = popRightmost(left);
+    double gapStart = nodes[gap].start;
+    double gapEnd = nodes[gap].end;
+    freeNodes.push_back(gap);
+
+    left = merge(left, newNode(gapStart, start));
+    left = merge(left, newNode(finish, gapEnd));
+    root = merge(left, right);
+}
@@ -0,0 +1,55 @@
+#ifndef TILETIMELINE_H
+#define TILETIMELINE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 单个 TILE 的占用时间线。空闲区间（gap，含长度为 0 的 gap）按起点存放在 treap 中，
+// 每个结点维护子树内的最大 gap 长度，从而：
+//   earliestStart: readyTime 之后最早可容纳 duration 的起始时间，O(log n)
+//   occupy:        占用 [start, finish)，拆分所在 gap，O(log n)
+// 与按起点排序的事件列表上的线性插入式查找结果一致。
+class TileTimeline {
+public:
+    TileTimeline();
+
+    double earliestStart(double readyTime, double duration) const;
+
+    // [start, finish) 必须是 earliestStart 给出的位置
+    void occupy(double start, double finish);
+
+    void clear();
+
+    // 用已占用区间重建时间线，O(k)。busy 须按 (开始, 结束) 升序且互不重叠；
+    // 得到的空闲时段与按任意顺序逐个 occupy 这些区间的结果相同
+    void rebuild(const std::vector<std::pair<double, double>>& busy);
+
+    int gapCount() const;
+
+private:
+    struct Node {
+        double start;
+        double end;
+        double length;
+        double maxLength;
+        int left;
+        int right;
+        uint32_t priority;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int root;
+    uint32_t seed;
+
+    int newNode(double start, double end);
+    void update(int node);
+    void updateSubtree(int node);
+    int merge(int a, int b);
+    void splitAfter(int node, double key, int& left, int& right);
+    int popRightmost(int& tree);
+    int firstFitAfter(int node, double readyTime, double duration) const;
+};
+
+#endif // TILETIMELINE_H
@@ -0,0 +1,117 @@
+#include "Trace.hpp"
+#include "JsonStream.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+
+namespace {
+
+const int kPhaseCount = static_cast<int>(TracePhase::Count);
+const int kCounterCount = static_cast<int>(TraceCounter::Count);
+
+const char* const kPhaseNames[kPhaseCount] = {
+    "parse", "convert", "cost_tables", "rank", "allocate", "emit"
+};
+
+const char* const kCounterNames[kCounterCount] = {
+    "tasks_allocated", "parallel_tasks", "tiles_evaluated", "slot_probes", "gaps_scanned", "slots_occupied",
+    "transfers_booked"
+};
+
+std::atomic<std::uint64_t> phaseNanoseconds[kPhaseCount];
+std::atomic<std::uint64_t> phaseCalls[kPhaseCount];
+std::atomic<std::uint64_t> counters[kCounterCount];
+
+long long peakRssKb() {
+    // ru_maxrss 在 execve 之后保留父进程的峰值，优先读取本进程地址空间的 VmHWM
+    if (std::FILE* status = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        long long kb = -1;
+        while (std::fgets(line, sizeof(line), status)) {
+            if (std::strncmp(line, "VmHWM:", 6) == 0) {
+                kb = std::atoll(line + 6);
+                break;
+            }
+        }
+        std::fclose(status);
+        if (kb >= 0) {
+            return kb;
+        }
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+}
+
+void Trace::addPhase(TracePhase phase, std::uint64_t nanoseconds) {
+    int index = static_cast<int>(phase);
+    phaseNanoseconds[index].fetch_add(nanoseconds, std::memory_order_relaxed);
+    phaseCalls[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Trace::addCount(TraceCounter counter, std::uint64_t amount) {
+    counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Trace::reset() {
+    for (int i = 0; i < kPhaseCount; ++i) {
+        phaseNanoseconds[i].store(0, std::memory_order_relaxed);
+        phaseCalls[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < kCounterCount; ++i) {
+        counters[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string Trace::report(std::string_view input, const std::vector<std::pair<const char*, double>>& schedule) {
+    std::string text;
+    JsonStream out(text, nullptr, false);
+    out.beginObject();
+    out.key("input");
+    out.value(input);
+    out.key("trace_points");
+    out.value(static_cast<long long>(HEFT_TRACE));
+
+    out.key("phases");
+    out.beginObject();
+    for (int i = 0; i < kPhaseCount; ++i) {
+        out.key(kPhaseNames[i]);
+        out.beginObject();
+        out.key("calls");
+        out.value(static_cast<long long>(phaseCalls[i].load(std::memory_order_relaxed)));
+        out.key("us");
+        out.value(static_cast<long long>(phaseNanoseconds[i].load(std::memory_order_relaxed) / 1000));
+        out.endObject();
+    }
+    out.endObject();
+
+    // 未编译计数点时计数器恒为 0，不输出以免误读
+    if (HEFT_TRACE) {
+        out.key("counters");
+        out.beginObject();
+        for (int i = 0; i < kCounterCount; ++i) {
+            out.key(kCounterNames[i]);
+            out.value(static_cast<long long>(counters[i].load(std::memory_order_relaxed)));
+        }
+        out.endObject();
+    }
+
+    if (!schedule.empty()) {
+        out.key("schedule");
+        out.beginObject();
+        for (const auto& metric : schedule) {
+            out.key(metric.first);
+            out.value(metric.second);
+        }
+        out.endObject();
+    }
+
+    out.key("max_rss_kb");
+    out.value(peakRssKb());
+    out.endObject();
+    return text;
+}
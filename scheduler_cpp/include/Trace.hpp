@@ -0,0 +1,74 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// 热路径上的计数点只在 HEFT_TRACE=1 编译时存在（make TRACE=1），否则 HEFT_TRACE_COUNT 展开为空。
+// 阶段计时每个阶段只读两次时钟，始终开启。
+#ifndef HEFT_TRACE
+#define HEFT_TRACE 0
+#endif
+
+enum class TracePhase {
+    Parse,
+    Convert,
+    CostTables,
+    Rank,
+    Allocate,
+    Emit,
+    Count
+};
+
+enum class TraceCounter {
+    TasksAllocated,
+    ParallelTasks,      // 分片并行评估 EFT 的任务数
+    TilesEvaluated,
+    SlotProbes,         // TileTimeline::earliestStart 调用次数
+    GapsScanned,        // 查找空闲时段时访问的 gap 节点数
+    SlotsOccupied,
+    TransfersBooked,    // 链路竞争模式下预约的跨 TILE 传输数
+    Count
+};
+
+// 进程级累计的阶段耗时与计数器（原子量，多线程 / 服务模式下为所有请求之和）
+class Trace {
+public:
+    static void addPhase(TracePhase phase, std::uint64_t nanoseconds);
+    static void addCount(TraceCounter counter, std::uint64_t amount);
+    static void reset();
+
+    // 单行 JSON：{"input":...,"trace_points":0|1,"phases":{名字:{"calls":n,"us":n}},"counters":{...},
+    // "schedule":{名字:值},"max_rss_kb":n}；schedule 为调用者给出的本次结果指标（如 makespan）
+    static std::string report(std::string_view input,
+                              const std::vector<std::pair<const char*, double>>& schedule = {});
+};
+
+// 作用域计时：析构时把经过的时间累加到对应阶段
+class PhaseTimer {
+public:
+    explicit PhaseTimer(TracePhase phase) : phase(phase), begin(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+        Trace::addPhase(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    TracePhase phase;
+    std::chrono::steady_clock::time_point begin;
+};
+
+#if HEFT_TRACE
+#define HEFT_TRACE_COUNT(counter, amount) Trace::addCount(TraceCounter::counter, (amount))
+#else
+#define HEFT_TRACE_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,79 @@
+#include "WorkerPool.hpp"
+
+WorkerPool::WorkerPool(int threadCount) {
+    for (int shard = 1; shard < threadCount; ++shard) {
+        workers.emplace_back(&WorkerPool::workerLoop, this, shard);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int WorkerPool::size() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+void WorkerPool::shardRange(int shard, int& begin, int& end) const {
+    int shards = size();
+    begin = static_cast<int>(static_cast<long long>(count) * shard / shards);
+    end = static_cast<int>(static_cast<long long>(count) * (shard + 1) / shards);
+}
+
+void WorkerPool::run(int itemCount, JobFunction jobFunction, void* jobContext) {
+    if (workers.empty()) {
+        jobFunction(jobContext, 0, 0, itemCount);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        function = jobFunction;
+        context = jobContext;
+        count = itemCount;
+        pending = static_cast<int>(workers.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    int begin;
+    int end;
+    shardRange(0, begin, end);
+    jobFunction(jobContext, 0, begin, end);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+}
+
+void WorkerPool::workerLoop(int shard) {
+    unsigned seen = 0;
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        int begin;
+        int end;
+        shardRange(shard, begin, end);
+        JobFunction jobFunction = function;
+        void* jobContext = context;
+        lock.unlock();
+
+        if (begin < end) {
+            jobFunction(jobContext, shard, begin, end);
+        }
+
+        lock.lock();
+        if (--pending == 0) {
+            done.notify_one();
+        }
+    }
+}
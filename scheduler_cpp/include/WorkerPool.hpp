@@ -0,0 +1,49 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 常驻线程池：parallelFor 把 [0, count) 均分成 size() 段，调用线程执行第 0 段，
+// 其余段由常驻线程执行，全部完成后返回。线程在两次调用之间阻塞等待，不会重新创建。
+// 同一时刻只允许一个调用者使用同一个线程池。
+class WorkerPool {
+public:
+    explicit WorkerPool(int threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const;
+
+    // job(shard, begin, end)；shard 的编号与区间一一对应且与线程调度无关
+    template <typename Job>
+    void parallelFor(int count, Job& job) {
+        run(count, [](void* context, int shard, int begin, int end) {
+            (*static_cast<Job*>(context))(shard, begin, end);
+        }, &job);
+    }
+
+private:
+    using JobFunction = void (*)(void*, int, int, int);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    JobFunction function = nullptr;
+    void* context = nullptr;
+    int count = 0;
+    int pending = 0;
+    unsigned generation = 0;
+    bool stopping = false;
+
+    void run(int count, JobFunction function, void* context);
+    void workerLoop(int shard);
+    void shardRange(int shard, int& begin, int& end) const;
+};
+
+#endif // WORKERPOOL_H
@@ -1,11 +1,18 @@
+#include "./include/PlanningAlgorithm.hpp"
 #include "./include/HEFTPlanningAlgorithm.hpp"
+#include "./include/BatchScheduler.hpp"
+#include "./include/DagFile.hpp"
+#include "./include/HardwareDescription.hpp"
 #include "./include/JsonParser.hpp"
-#include "./include/JsonWriter.hpp"
+#include "./include/ScheduleEmitter.hpp"
+#include "./include/ScheduleCache.hpp"
+#include "./include/ScheduleServer.hpp"
 #include "./include/TaskConverter.hpp"
-#include "./include/InputTile.hpp"
+#include "./include/Trace.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
-#include <iomanip>
-#include <sstream>
+#include <memory>
 #include <random>
 #include <utility>
 #include <nlohmann/json.hpp>
@@ -14,166 +21,225 @@ using json = nlohmann::json;
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3) {
-        std::cerr << "Usage: " << argv[0] << " <input_file> <output_file>" << std::endl;
-        return 1;
+    std::vector<std::string> positional;
+    std::string socketPath;
+    std::string traceReport;
+    std::string hardwareFile;
+    std::string cacheDir;
+    std::string batchSource;
+    std::string outDir = "./DAG";
+    std::string plannerName = "heft";
+    std::size_t cacheEntries = 0;
+    int threads = 1;
+    bool compact = false;
+    bool toDag = false;
+    bool contention = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--compact") {
+            compact = true;
+        } else if (arg == "--contention") {
+            contention = true;
+        } else if (arg == "--to-dag") {
+            toDag = true;
+        } else if (arg == "--serve" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batchSource = argv[++i];
+        } else if (arg == "--out-dir" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if ((arg == "--hardware" || arg == "--tiles") && i + 1 < argc) {
+            hardwareFile = argv[++i];
+        } else if (arg == "--planner" && i + 1 < argc) {
+            plannerName = argv[++i];
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cacheEntries = static_cast<std::size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--cache-dir" && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (arg == "--trace-report" && i + 1 < argc) {
+            traceReport = argv[++i];
+        } else {
+            positional.push_back(arg);
+        }
     }
-    std::string inputFile = argv[1];
-    std::string outputFile = argv[2];
-
-    std::vector<inputTask> inputtasks = JsonParser::parseJson(inputFile);
-    std::vector<Tile> tiles = InputTile::setupTiles();
-
-    //Developer can change their own schedule algoithm
-    
-    auto result = TaskConverter::convertToTasks(inputtasks);
 
-    std::vector<Task> tasks = result.first;
-    std::unordered_map<std::string, int> idMapping = result.second;
+    const auto& planners = PlanningAlgorithm::names();
+    if (std::find(planners.begin(), planners.end(), plannerName) == planners.end()) {
+        std::cerr << "Unknown planner: " << plannerName << " (expected heft or peft)" << std::endl;
+        return 1;
+    }
 
-    HEFTPlanningAlgorithm heftPlanner(tasks, tiles);
-    heftPlanner.run();
+    // 硬件描述（--hardware，旧名 --tiles）只解析一次，通信代价矩阵随之只求一次，各规划器共享；
+    // 未指定时使用内置描述。--contention 等同于在描述的 noc 中设置 "contention": true
+    std::shared_ptr<const HardwareDescription> hardware;
+    try {
+        hardware = hardwareFile.empty() ? HardwareDescription::builtin() : HardwareDescription::load(hardwareFile);
+        if (contention && !hardware->topology().contention) {
+            MeshTopology topology = hardware->topology();
+            topology.contention = true;
+            hardware = std::make_shared<const HardwareDescription>(hardware->tiles(), topology);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load " << hardwareFile << ": " << e.what() << std::endl;
+        return 1;
+    }
 
-    std::vector<std::pair<int, double>> rankkk = heftPlanner.getRanks();
+    // --cache 为内存层条目数，--cache-dir 为磁盘层目录；单次运行只有磁盘层有意义
+    std::unique_ptr<ScheduleCache> cache;
+    if (cacheEntries > 0 || !cacheDir.empty()) {
+        cache.reset(new ScheduleCache(cacheEntries, cacheDir));
+    }
 
-    std::vector<std::pair<std::string, double>> mappedTaskData;
-    std::string mappedTaskId;
+    // 服务模式：--threads 为并发处理请求的常驻线程数
+    if (!socketPath.empty() && positional.empty()) {
+        try {
+            ScheduleServer server(socketPath, hardware, threads, cache.get(), plannerName);
+            server.run();
+        } catch (const std::exception& e) {
+            std::cerr << "Server failed: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
-    for (const auto &entry : rankkk)
-    {
-        for (const auto &pair : idMapping)
-        {
-            if (pair.second == entry.first)
-            {
-                mappedTaskId = pair.first;
-                mappedTaskData.push_back({mappedTaskId, entry.second});
-                break;
-            }
+    // 批处理模式：--threads 为工作线程数，每个输入写出结果与 .diag.json，最后在 stdout 输出一行汇总
+    if (!batchSource.empty() && positional.empty()) {
+        BatchSummary summary;
+        try {
+            std::vector<BatchJob> jobs = BatchScheduler::collectJobs(batchSource, outDir);
+            summary = BatchScheduler::run(jobs, hardware, plannerName, threads, compact, cache.get());
+        } catch (const std::exception& e) {
+            std::cerr << "Batch failed: " << e.what() << std::endl;
+            return 1;
         }
+        std::string line;
+        JsonStream out(line, nullptr, false);
+        out.beginObject();
+        out.key("dags"); out.value(static_cast<long long>(summary.total));
+        out.key("failed"); out.value(static_cast<long long>(summary.failed));
+        out.key("threads"); out.value(static_cast<long long>(threads));
+        out.key("seconds"); out.value(summary.seconds);
+        out.key("dags_per_second"); out.value(summary.seconds > 0.0 ? summary.total / summary.seconds : 0.0);
+        out.endObject();
+        std::cout << line << std::endl;
+        return summary.failed == 0 ? 0 : 1;
     }
 
-    std::vector<inputTask> output = inputtasks;
-    std::unordered_map<std::string, int> sequentialMapping;
-    int sequentialCounter = 0;
+    if (positional.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " <input.json|input.dag> <output_file> [--threads N] [--compact] [--planner heft|peft] [--hardware <file>] [--contention] [--cache-dir <dir>] [--trace-report <file|->]" << std::endl;
+        std::cerr << "       " << argv[0] << " --to-dag <input.json> <output.dag>" << std::endl;
+        std::cerr << "       " << argv[0] << " --batch <manifest|dir> [--out-dir <dir>] [--threads N] [--compact] [--planner heft|peft] [--hardware <file>] [--contention] [--cache N] [--cache-dir <dir>]" << std::endl;
+        std::cerr << "       " << argv[0] << " --serve <socket_path> [--threads N] [--planner heft|peft] [--hardware <file>] [--contention] [--cache N] [--cache-dir <dir>]" << std::endl;
+        return 1;
+    }
+    std::string inputFile = positional[0];
+    std::string outputFile = positional[1];
+
+    // 输入可以是 JSON 或 .dag（按魔数识别）；.dag 直接映射，规划与输出都不构造 inputTask / Task
+    std::unique_ptr<DagFile> dagFile;
+    StringPool pool;
+    std::vector<inputTask> inputtasks;
+    try {
+        if (DagFile::isDagFile(inputFile)) {
+            dagFile.reset(new DagFile(inputFile));
+        } else {
+            inputtasks = JsonParser::parseJsonStream(inputFile, pool);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load " << inputFile << ": " << e.what() << std::endl;
+        return 1;
+    }
 
-    for (const auto &data : mappedTaskData) {
-        sequentialMapping[data.first] = sequentialCounter++;
+    // --to-dag：只做格式转换，不规划
+    if (toDag) {
+        if (dagFile) {
+            std::cerr << inputFile << " is already a .dag file" << std::endl;
+            return 1;
+        }
+        try {
+            DagFile::write(outputFile, inputtasks, pool);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to write " << outputFile << ": " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
     }
 
-    for (auto &task : output) {
-        task.taskId = std::to_string(sequentialMapping[task.taskId]);
+    // --planner 选择规划器（见 PlanningAlgorithm）；服务模式下可按请求指定
+    std::vector<Task> tasks;
+    std::unordered_map<Symbol, int> idMapping;
+    if (!dagFile) {
+        auto result = TaskConverter::convertToTasks(inputtasks);
+        tasks = std::move(result.first);
+        idMapping = std::move(result.second);
+    }
 
-        for (auto &parentTaskId : task.parentTasks) {
-            if (std::get<0>(parentTaskId) != "-1") {
-                std::get<0>(parentTaskId) = std::to_string(sequentialMapping[std::get<0>(parentTaskId)]);
-            }
+    std::vector<std::pair<const char*, double>> metrics;
+    auto plan = [&]() {
+        WorkerPool workerPool(threads);
+        std::unique_ptr<PlanningAlgorithm> planner = PlanningAlgorithm::create(plannerName, tasks, hardware);
+        planner->setWorkerPool(&workerPool);
+        if (dagFile) {
+            planner->run(*dagFile);
+        } else {
+            planner->run();
+        }
+        metrics = {{"makespan", planner->getMakespan()}, {"slr", planner->getScheduleLengthRatio()}};
+        return CachedSchedule{planner->getRanks(), planner->getTaskEvents()};
+    };
+    std::shared_ptr<const CachedSchedule> planned;
+    try {
+        bool hit = false;
+        if (cache) {
+            std::string key = dagFile ? ScheduleCache::digest(*dagFile, *hardware, plannerName)
+                                      : ScheduleCache::digest(tasks, *hardware, plannerName);
+            std::size_t taskCount = dagFile ? dagFile->taskCount() : tasks.size();
+            planned = cache->getOrPlan(key, taskCount, plan, &hit);
+        } else {
+            planned = std::make_shared<const CachedSchedule>(plan());
         }
-        for (auto &childTaskId : task.childTasks) {
-            if (std::get<0>(childTaskId) != "-1") {
-                std::get<0>(childTaskId) = std::to_string(sequentialMapping[std::get<0>(childTaskId)]);    
+        if (hit) {
+            double makespan = 0.0;
+            for (const auto& event : planned->taskEvents) {
+                makespan = std::max(makespan, event.finish);
             }
+            metrics = {{"makespan", makespan}, {"cache_hit", 1.0}};
         }
+    } catch (const std::exception& e) {
+        std::cerr << "Planning failed: " << e.what() << std::endl;
+        return 1;
     }
-  
-    std::ofstream outputFileStream(outputFile, std::ios::out);
+
+    std::ofstream outputFileStream(outputFile, std::ios::out | std::ios::binary);
 
     if (!outputFileStream.is_open()) {
         std::cerr << "Error opening the output file: " << outputFile << std::endl;
         return 1;
     }
 
-    json outputJson;
-    json returnJson;
-    json returnJson_info;
-    
-    for (int count=0; count < sequentialCounter ; count++)
-    {   
-        json taskJson;                       
-        json parentTasksJson;
-    
-        for (const auto& task : output) {
-            if (task.taskId == std::to_string(count)) {
-                auto it = std::find_if(sequentialMapping.begin(), sequentialMapping.end(),
-                    [count](const std::pair<const std::string, int>& pair) { return pair.second == count; });
-                if (it != sequentialMapping.end()) {
-                    taskJson["debug_task_name"] = it->first;
-                } 
-                taskJson["current_taskId"] = count;
-                taskJson["text_offset"]    = task.text_offset;
-                taskJson["data_offset"]    = task.data_offset;
-                taskJson["total_length"]   = task.total_length;
-                taskJson["text_length"]    = task.text_length;
-                taskJson["data_length"]    = task.data_length;
-                taskJson["hardwareinfo"]   = task.hardwareinfo; // last 5 bits :spm_size lane_num has_serdiv has_complexunit has_bitalu
-                taskJson["hash"]           = task.hash;
-                taskJson["Input_Num"]      = task.parentTasks.size() + task.global_Input.size() + task.para_Input.size();
-                taskJson["Output_Num"]     = task.output_num;
-
-                for (size_t i = 0; i < task.global_Input.size(); ++i) {
-                    auto global_Id = task.global_Input[i].first; 
-                    auto global_addr = task.global_Input[i].second; 
-                    JsonWriter::writeBinaryToJson_data_global(parentTasksJson, global_Id, global_addr);
-                }
-
-                for (size_t i = 0; i < task.para_Input.size(); ++i) {
-                    auto para_Id = std::get<0>(task.para_Input[i]); 
-                    auto para_addr = std::get<1>(task.para_Input[i]); 
-                    auto para_slice_length = std::get<2>(task.para_Input[i]); 
-                    auto para_slice_data_type = std::get<3>(task.para_Input[i]); 
-                    auto decimal_dest_address = std::stoi(para_addr, nullptr, 16);
-                    int slice_data_addr = std::stoi(para_slice_length) * std::stoi(para_slice_data_type) ;
-                    int slice_data_dest = decimal_dest_address + slice_data_addr;
-                    std::stringstream ss;
-                    ss << std::hex << std::uppercase << slice_data_dest;
-                    std::string hex_slice_data_dest_str = ss.str();
-                    JsonWriter::writeBinaryToJson_data_para(parentTasksJson, para_Id, para_addr, para_slice_length, para_slice_data_type,hex_slice_data_dest_str);
-                }
-
-                for (size_t i = 0; i < task.return_output.size(); ++i) {
-                    auto return_Id = task.return_output[i].first; 
-                    auto return_port = task.return_output[i].second; 
-                    auto parentTaskId = task.taskId;
-                    JsonWriter::writeBinaryToJson_data(returnJson_info,return_Id,parentTaskId,return_port);
-                }
-
-                for (size_t i = 0; i < task.parentTasks.size(); ++i) {
-                    auto parentTaskId = std::get<0>(task.parentTasks[i]); // 获取父任务的 ID
-                    int childTaskSize;
-                    int port_num = std::get<1>(task.parentTasks[i]);
-                    std::string dest_address = std::get<2>(task.parentTasks[i]);
-                    int concat_value = std::get<3>(task.parentTasks[i]);
-                    std::string slice_length = std::get<4>(task.parentTasks[i]);
-                    std::string slice_data_type = std::get<5>(task.parentTasks[i]);
-                    auto decimal_dest_address = std::stoi(dest_address, nullptr, 16);
-                    int slice_data_addr = std::stoi(slice_length) * std::stoi(slice_data_type) ;
-                    int slice_data_dest = decimal_dest_address + slice_data_addr;
-                    auto varname = std::get<6>(task.parentTasks[i]); 
-                    std::stringstream ss;
-                    ss << std::hex << std::uppercase << slice_data_dest;
-                    std::string hex_slice_data_dest_str = ss.str();
-                    JsonWriter::writeBinaryToJson(parentTasksJson, parentTaskId, port_num, dest_address,concat_value,slice_length,slice_data_type,hex_slice_data_dest_str,varname);
-                }
-
-                if (returnJson_info.empty())
-                    returnJson["return_output"] = "None";
-                else
-                    returnJson["return_output"] = returnJson_info;
-                if (parentTasksJson.empty())
-                    taskJson["all_input"] = "None";
-                else
-                    taskJson["all_input"] = parentTasksJson;
-                break;
-            
-        }
-        
-        }
-        
-        outputJson.push_back(taskJson);
+    // 逐个任务直接序列化到文件，不构造 json 树
+    std::string buffer;
+    JsonStream out(buffer, &outputFileStream, !compact);
+    if (dagFile) {
+        ScheduleEmitter::writeOutput(out, *dagFile, planned->ranks, planned->taskEvents);
+    } else {
+        ScheduleEmitter::writeOutput(out, inputtasks, pool, idMapping, planned->ranks, planned->taskEvents);
     }
-    outputJson.push_back(returnJson);
-    outputFileStream << std::setw(4) << outputJson;
 
     outputFileStream.close();
 
+    // 每次运行追加一行 JSON，"-" 表示写到 stderr
+    if (!traceReport.empty()) {
+        std::string line = Trace::report(inputFile, metrics);
+        if (traceReport == "-") {
+            std::cerr << line << std::endl;
+        } else {
+            std::ofstream reportStream(traceReport, std::ios::out | std::ios::app);
+            reportStream << line << '\n';
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,236 @@
+// Python 扩展模块 heft_native：进程内直接调用调度器，规划期间释放 GIL。
+//
+//   plan(costs, edge_source, edge_target, spm_size=None, num_lane=None, features=None, planner="heft",
+//        edge_bytes=None, hardware=None)
+//       costs 为 float64 缓冲区（array('d')），其余为 int32 缓冲区（array('i')）。
+//       hardware 为硬件描述的 JSON 文本（str 或 bytes，格式见 HardwareDescription），省略时使用内置描述；
+//       相同的描述只解析一次。省略能力数组时所有任务使用第一个 TILE 的能力。planner 为 "heft" 或 "peft"。
+//       edge_bytes 为每条边传输的字节数，省略时为 0（跨 TILE 只计延迟）。
+//       返回按 rank 顺序排列的 [(task, core_id, start_cycle, finish_cycle), ...]。
+//   schedule_json(payload)
+//       payload 为输入文件格式的 JSON（str 或 bytes），或 {"planner": "peft", "hardware": {...}, "tasks": [...]}，
+//       返回与输出文件逐字节一致的 str。
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "PlanningAlgorithm.hpp"
+#include "HardwareDescription.hpp"
+#include "HEFTPlanningAlgorithm.hpp"
+#include "ScheduleEmitter.hpp"
+#include "ScheduleServer.hpp"
+#include "TaskConverter.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 持有一个 C 连续缓冲区视图，析构时释放
+class BufferView {
+public:
+    BufferView() { std::memset(&view, 0, sizeof(view)); }
+    ~BufferView() {
+        if (view.obj != nullptr) {
+            PyBuffer_Release(&view);
+        }
+    }
+
+    BufferView(const BufferView&) = delete;
+    BufferView& operator=(const BufferView&) = delete;
+
+    // 失败时已设置 Python 异常
+    bool acquire(PyObject* object, const char* name, char code, Py_ssize_t itemSize) {
+        if (PyObject_GetBuffer(object, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+            return false;
+        }
+        const char* format = view.format != nullptr ? view.format : "B";
+        char last = format[std::strlen(format) - 1];
+        bool intAlias = code == 'i' && last == 'l';
+        if (view.itemsize != itemSize || (last != code && !intAlias)) {
+            PyErr_Format(PyExc_TypeError, "%s must be a buffer of '%c' items of %zd bytes", name, code, itemSize);
+            return false;
+        }
+        return true;
+    }
+
+    Py_ssize_t size() const { return view.len / view.itemsize; }
+
+    template <typename T>
+    const T* data() const { return static_cast<const T*>(view.buf); }
+
+private:
+    Py_buffer view;
+};
+
+PyObject* raiseFromCpp(const std::string& message, bool invalidArgument) {
+    PyErr_SetString(invalidArgument ? PyExc_ValueError : PyExc_RuntimeError, message.c_str());
+    return nullptr;
+}
+
+PyObject* plan(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"costs", "edge_source", "edge_target", "spm_size", "num_lane", "features", "planner",
+                                     "edge_bytes", "hardware", nullptr};
+    PyObject* costsObject;
+    PyObject* sourceObject;
+    PyObject* targetObject;
+    PyObject* spmObject = Py_None;
+    PyObject* laneObject = Py_None;
+    PyObject* featureObject = Py_None;
+    const char* plannerName = "heft";
+    PyObject* bytesObject = Py_None;
+    const char* hardwareText = nullptr;
+    Py_ssize_t hardwareSize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|OOOsOz#", const_cast<char**>(keywords), &costsObject,
+                                     &sourceObject, &targetObject, &spmObject, &laneObject, &featureObject,
+                                     &plannerName, &bytesObject, &hardwareText, &hardwareSize)) {
+        return nullptr;
+    }
+    std::shared_ptr<const HardwareDescription> hardware = HardwareDescription::builtin();
+    if (hardwareText != nullptr) {
+        // 描述很小且通常已在缓存中，持有 GIL 解析
+        try {
+            hardware = HardwareDescription::parse(std::string_view(hardwareText, hardwareSize));
+        } catch (const std::invalid_argument& e) {
+            return raiseFromCpp(std::string("hardware: ") + e.what(), true);
+        }
+    }
+
+    BufferView costs, source, target, spm, lane, features, bytes;
+    if (!costs.acquire(costsObject, "costs", 'd', sizeof(double)) ||
+        !source.acquire(sourceObject, "edge_source", 'i', sizeof(int)) ||
+        !target.acquire(targetObject, "edge_target", 'i', sizeof(int))) {
+        return nullptr;
+    }
+    Py_ssize_t taskCount = costs.size();
+    Py_ssize_t edgeCount = source.size();
+    if (target.size() != edgeCount) {
+        PyErr_SetString(PyExc_ValueError, "edge_source and edge_target must have the same length");
+        return nullptr;
+    }
+    const int* edgeBytes = nullptr;
+    if (bytesObject != Py_None) {
+        if (!bytes.acquire(bytesObject, "edge_bytes", 'i', sizeof(int))) {
+            return nullptr;
+        }
+        if (bytes.size() != edgeCount) {
+            PyErr_SetString(PyExc_ValueError, "edge_bytes must have one entry per edge");
+            return nullptr;
+        }
+        edgeBytes = bytes.data<int>();
+    }
+
+    const std::vector<Tile>& tiles = hardware->tiles();
+    std::vector<int> defaults[3];
+    const int* capability[3];
+    PyObject* capabilityObjects[3] = {spmObject, laneObject, featureObject};
+    BufferView* capabilityViews[3] = {&spm, &lane, &features};
+    const char* capabilityNames[3] = {"spm_size", "num_lane", "features"};
+    int defaultValues[3] = {
+        tiles[0].spm_size, tiles[0].num_lane,
+        (tiles[0].has_bitalu ? 1 : 0) | (tiles[0].has_serdiv ? 2 : 0) | (tiles[0].has_complexunit ? 4 : 0)
+    };
+    for (int field = 0; field < 3; ++field) {
+        if (capabilityObjects[field] == Py_None) {
+            defaults[field].assign(taskCount, defaultValues[field]);
+            capability[field] = defaults[field].data();
+            continue;
+        }
+        if (!capabilityViews[field]->acquire(capabilityObjects[field], capabilityNames[field], 'i', sizeof(int))) {
+            return nullptr;
+        }
+        if (capabilityViews[field]->size() != taskCount) {
+            PyErr_Format(PyExc_ValueError, "%s must have one entry per task", capabilityNames[field]);
+            return nullptr;
+        }
+        capability[field] = capabilityViews[field]->data<int>();
+    }
+
+    std::vector<std::pair<int, double>> ranks;
+    std::vector<Event> events;
+    std::string error;
+    bool invalidArgument = false;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        std::vector<Task> tasks = TaskConverter::buildTasks(
+            static_cast<int>(taskCount), costs.data<double>(), capability[0], capability[1], capability[2],
+            static_cast<int>(edgeCount), source.data<int>(), target.data<int>(), edgeBytes);
+        std::unique_ptr<PlanningAlgorithm> planner =
+            PlanningAlgorithm::create(plannerName, tasks, hardware);
+        planner->run();
+        ranks = planner->getRanks();
+        events = planner->getTaskEvents();
+    } catch (const std::invalid_argument& e) {
+        error = e.what();
+        invalidArgument = true;
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+    if (!error.empty()) {
+        return raiseFromCpp(error, invalidArgument);
+    }
+
+    PyObject* result = PyList_New(static_cast<Py_ssize_t>(ranks.size()));
+    if (result == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < ranks.size(); ++i) {
+        const Event& event = events[ranks[i].first];
+        PyObject* item = Py_BuildValue("(iiLL)", ranks[i].first, event.tileId,
+                                       ScheduleEmitter::toCycle(event.start), ScheduleEmitter::toCycle(event.finish));
+        if (item == nullptr) {
+            Py_DECREF(result);
+            return nullptr;
+        }
+        PyList_SET_ITEM(result, static_cast<Py_ssize_t>(i), item);
+    }
+    return result;
+}
+
+PyObject* scheduleJson(PyObject*, PyObject* args) {
+    const char* data;
+    Py_ssize_t size;
+    if (!PyArg_ParseTuple(args, "s#", &data, &size)) {
+        return nullptr;
+    }
+    // s# 对 bytes 与 str 都返回内部缓冲区，参数对象在调用期间保持存活
+    std::string output;
+    std::string error;
+    bool invalidArgument = false;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        output = ScheduleServer::schedule(std::string_view(data, size), HardwareDescription::builtin());
+    } catch (const std::invalid_argument& e) {
+        error = e.what();
+        invalidArgument = true;
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+    if (!error.empty()) {
+        return raiseFromCpp(error, invalidArgument);
+    }
+    return PyUnicode_FromStringAndSize(output.data(), static_cast<Py_ssize_t>(output.size()));
+}
+
+PyMethodDef methods[] = {
+    {"plan", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(plan)), METH_VARARGS | METH_KEYWORDS,
+     "plan(costs, edge_source, edge_target, spm_size=None, num_lane=None, features=None, planner='heft', "
+     "edge_bytes=None, hardware=None) -> "
+     "[(task, core_id, start_cycle, finish_cycle), ...] in rank order"},
+    {"schedule_json", scheduleJson, METH_VARARGS,
+     "schedule_json(payload) -> schedule JSON, identical to the scheduler's output file"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef moduleDef = {
+    PyModuleDef_HEAD_INIT, "heft_native", "In-process HEFT/PEFT scheduler; planning releases the GIL.", -1, methods,
+    nullptr, nullptr, nullptr, nullptr
+};
+
+}
+
+PyMODINIT_FUNC PyInit_heft_native(void) {
+    return PyModule_Create(&moduleDef);
+}